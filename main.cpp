@@ -3,15 +3,36 @@
 #include "mrv_heuristic.h"
 #include "lcv_heuristic.h"
 #include "forward_checking_data.h"
+#include "incremental_solver.h"
+#include "crossing_graph.h"
+#include "word_index.h"
+#include "resumable_search.h"
+#include "search_scheduler.h"
+#include "search_checkpoint.h"
+#include "search_strategies.h"
+#include "search_estimate.h"
+#include "frame_generator.h"
 
 #include <iostream>
 #include <chrono>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <memory>
+#include <stdexcept>
 
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    bool generating_frames = argc > 2 && std::string(argv[2]) == "generate-frame";
+    bool interleaving = argc > 2 && std::string(argv[2]) == "interleave";
+    bool estimating = argc > 2 && std::string(argv[2]) == "estimate";
+    if (generating_frames ? argc != 5 && argc != 6 : estimating ? argc != 4 : !interleaving && argc != 3)
     {
-        std::cout << "Correct usage: " << argv[0] << " <puzzle directory> <standard-backtracking|mrv|lcv|fc+mrv>\n";
+        std::cout << "Correct usage: " << argv[0] << " <puzzle directory> <auto|standard-backtracking|mrv|lcv|fc+mrv|wdeg|tree-decomposition|local-search|incremental>\n";
+        std::cout << "           or: " << argv[0] << " <puzzle directory> generate-frame <size> <black squares> [frame count]\n";
+        std::cout << "           or: " << argv[0] << " <puzzle directory> interleave [puzzle directory...]\n";
+        std::cout << "           or: " << argv[0] << " <puzzle directory> estimate <standard-backtracking|mrv|lcv|fc+mrv|wdeg>\n";
+        std::cout << "tree-decomposition suits grids of dense regions joined by a few words; on densely interlocked grids fc+mrv is faster.\n";
         return 1;
     }
 
@@ -23,46 +44,243 @@ int main(int argc, char* argv[])
     }
 
     std::string algorithm = argv[2];
-    if (algorithm != "standard-backtracking" && algorithm != "mrv" && algorithm != "lcv" && algorithm != "fc+mrv")
+    if (algorithm != "auto" && algorithm != "standard-backtracking" && algorithm != "mrv" && algorithm != "lcv" && algorithm != "fc+mrv" && algorithm != "wdeg" && algorithm != "tree-decomposition" && algorithm != "local-search" && algorithm != "incremental" && !generating_frames && !interleaving && !estimating)
     {
-        std::cout << "Invalid algorithm provided. Valid options are standard-backtracking, mrv, lcv, and fc+mrv.\n";
+        std::cout << "Invalid algorithm provided. Valid options are auto, standard-backtracking, mrv, lcv, fc+mrv, wdeg, tree-decomposition, local-search, incremental, generate-frame, interleave, and estimate.\n";
+        return 1;
+    }
+
+    std::string estimated_algorithm = estimating ? argv[3] : "";
+    if (estimating && estimated_algorithm != "standard-backtracking" && estimated_algorithm != "mrv" && estimated_algorithm != "lcv" && estimated_algorithm != "fc+mrv" && estimated_algorithm != "wdeg")
+    {
+        std::cout << "Invalid algorithm to estimate provided. Valid options are standard-backtracking, mrv, lcv, fc+mrv, and wdeg.\n";
         return 1;
     }
 
-    auto [crossword_puzzle, crossword_entries] = Crossword_Utils::parse_puzzle(puzzle_directory);
     auto constrained_words = Crossword_Utils::get_constrained_words(puzzle_directory);
 
-    Crossword_Constructor crossword_constructor(crossword_puzzle, crossword_entries, constrained_words);
+    if (generating_frames)
+    {
+        int size = std::stoi(argv[3]);
+        int black_squares = std::stoi(argv[4]);
+        int frame_count = argc == 6 ? std::stoi(argv[5]) : 1;
+        std::unique_ptr<Frame_Generator> generator;
+        try
+        {
+            generator = std::make_unique<Frame_Generator>(size, black_squares, constrained_words, std::random_device()());
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cout << error.what() << '\n';
+            return 1;
+        }
+        auto& frame_generator = *generator;
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        int generated_frames = 0;
+        while (generated_frames < frame_count && frame_generator.consecutive_rejections < Frame_Generator::rejection_limit)
+        {
+            if (auto frame = frame_generator.next_frame())
+            {
+                std::cout << (generated_frames ? "\n" : "") << Frame_Generator::to_puzzle_text(*frame);
+                ++generated_frames;
+            }
+        }
+        auto stop_time = std::chrono::high_resolution_clock::now();
+        auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time);
+
+        std::cerr
+            << "Screened " << frame_generator.candidates << " candidate frames in " << duration_ms.count() << "ms ("
+            << frame_generator.rejected_layouts << " invalid layouts, "
+            << frame_generator.rejected_fills << " unfillable).\n";
+
+        if (generated_frames < frame_count)
+        {
+            std::cerr << "Gave up after " << Frame_Generator::rejection_limit << " candidate frames in a row were rejected.\n";
+            return 1;
+        }
+
+        return 0;
+    }
+
+    if (interleaving)
+    {
+        std::vector<std::string> puzzle_directories = { puzzle_directory };
+        for (int i = 3; i < argc; ++i)
+            puzzle_directories.push_back(argv[i]);
+
+        // Every search refers to its puzzle's graph and dictionary, so none of these may reallocate.
+        std::vector<std::unordered_map<int, std::vector<std::string>>> dictionaries;
+        std::vector<Word_Index> word_indices;
+        std::vector<Crossing_Graph> crossing_graphs;
+        dictionaries.reserve(puzzle_directories.size());
+        word_indices.reserve(puzzle_directories.size());
+        crossing_graphs.reserve(puzzle_directories.size());
+
+        Search_Scheduler scheduler(1000, std::min<std::size_t>(puzzle_directories.size(), std::max(std::thread::hardware_concurrency(), 1u)));
+        for (const auto& directory : puzzle_directories)
+        {
+            auto [crossword_puzzle, crossword_entries] = Crossword_Utils::parse_puzzle(directory);
+            dictionaries.push_back(directory == puzzle_directory ? constrained_words : Crossword_Utils::get_constrained_words(directory));
+            word_indices.emplace_back(dictionaries.back());
+            crossing_graphs.emplace_back(crossword_puzzle, crossword_entries);
+            auto strategy = std::make_unique<Forward_Checking_Strategy>(crossing_graphs.back(), word_indices.back());
+            scheduler.add(std::make_unique<Resumable_Search>(crossword_puzzle, crossing_graphs.back(), word_indices.back(), std::move(strategy)), 0);
+        }
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        bool all_generated = true;
+        scheduler.run([&](int search_id, const Resumable_Search& search)
+        {
+            auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time);
+            if (search.get_status() == Resumable_Search::Status::solved)
+            {
+                std::cout << puzzle_directories[search_id] << " (" << search.statistics.nodes << " nodes, " << duration_ms.count() << "ms):\n";
+                Crossword_Utils::print(std::cout, search.get_solution());
+            }
+            else
+            {
+                std::cout << "No valid solution exists for " << puzzle_directories[search_id] << " in combination with its dictionary.\n";
+                all_generated = false;
+            }
+        });
+
+        return all_generated ? 0 : 1;
+    }
+
+    if (algorithm == "incremental")
+    {
+        auto previous_solution = Incremental_Solver::parse_solution(puzzle_directory);
+        auto edits = Incremental_Solver::parse_edits(puzzle_directory);
+
+        Word_Index word_index(constrained_words);
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        auto solution = Incremental_Solver::solve(previous_solution, edits, word_index);
+        auto stop_time = std::chrono::high_resolution_clock::now();
+        auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time);
+
+        if (!solution)
+        {
+            std::cout << "No valid refill exists for the given edits in combination with the given dictionary.\n";
+            return 1;
+        }
+
+        Crossword_Utils::print(std::cout, *solution);
+        std::cout << "Time to refill: " << duration_ms.count() << "ms\n";
+
+        return 0;
+    }
+
+    auto [crossword_puzzle, crossword_entries] = Crossword_Utils::parse_puzzle(puzzle_directory);
+
+    Crossing_Graph crossing_graph(crossword_puzzle, crossword_entries);
+    Word_Index word_index(constrained_words);
+
+    if (estimating)
+    {
+        // The weights stay at 1, so every sample follows the tree of wdeg's first run.
+        WDEG_Heuristic heuristic(crossing_graph);
+        heuristic.learning = false;
+        auto make_search = [&]()
+        {
+            auto strategy = Crossword_Constructor::make_strategy(estimated_algorithm, crossing_graph, word_index, heuristic);
+            return std::make_unique<Resumable_Search>(crossword_puzzle, crossing_graph, word_index, std::move(strategy));
+        };
+
+        std::cout << Search_Estimate(make_search, std::chrono::milliseconds(250), std::random_device()()) << '\n';
+        return 0;
+    }
+
+    Crossword_Constructor crossword_constructor(constrained_words);
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
     bool generated = false;
+    std::ofstream selection_log;
     if (algorithm == "standard-backtracking")
     {
-        generated = crossword_constructor.construct_via_backtracking(crossword_puzzle);
+        generated = crossword_constructor.construct_via_backtracking(crossword_puzzle, crossing_graph, word_index);
     }
     else if (algorithm == "mrv")
     {
-        generated = crossword_constructor.construct_via_mrv(crossword_puzzle);
+        generated = crossword_constructor.construct_via_mrv(crossword_puzzle, crossing_graph, word_index);
+    }
+    else if (algorithm == "lcv")
+    {
+        generated = crossword_constructor.construct_via_lcv(crossword_puzzle, crossing_graph, word_index);
+    }
+    else if (algorithm == "wdeg")
+    {
+        WDEG_Heuristic heuristic(crossing_graph);
+        generated = crossword_constructor.construct_via_wdeg(crossword_puzzle, word_index, heuristic);
+    }
+    else if (algorithm == "tree-decomposition")
+    {
+        generated = crossword_constructor.construct_via_tree_decomposition(crossword_puzzle, crossing_graph, word_index);
+    }
+    else if (algorithm == "local-search")
+    {
+        generated = crossword_constructor.construct_via_local_search(crossword_puzzle, crossing_graph, word_index, std::thread::hardware_concurrency());
+    }
+    else if (algorithm == "auto")
+    {
+        // The decision is written before the chosen algorithm runs, so that it is kept even if the run is cut short.
+        selection_log.open(puzzle_directory + "/algorithm_selection.log", std::ios::app);
+        selection_log << "puzzle=" << puzzle_directory << ' ';
+        generated = crossword_constructor.construct_via_auto(crossword_puzzle, crossing_graph, word_index, selection_log);
     }
     else
     {
-        auto constraints = LCV_Heuristic::build_constraints(crossword_puzzle, crossword_entries);
-        if (algorithm == "lcv")
+        // Fill through a resumable search so that its position can be saved, and picked up again after an interruption.
+        auto make_search = [&]()
+        {
+            return std::make_unique<Resumable_Search>(crossword_puzzle, crossing_graph, word_index, std::make_unique<Forward_Checking_Strategy>(crossing_graph, word_index));
+        };
+        auto search_pointer = make_search();
+        Search_Checkpoint checkpoint(puzzle_directory, constrained_words, crossword_puzzle);
+        try
         {
-            generated = crossword_constructor.construct_via_lcv(crossword_puzzle, constraints);
+            if (checkpoint.load(*search_pointer))
+                std::cout << "Resuming from checkpoint after " << search_pointer->statistics.nodes << " nodes.\n";
         }
-        else
+        catch (const std::runtime_error& error)
         {
-            Forward_Checking_Data checked_words(constraints, crossword_puzzle, crossword_entries, constrained_words);
-            generated = crossword_constructor.construct_via_mrv_and_fc(crossword_puzzle, checked_words);
+            // A checkpoint of another dictionary or puzzle, or a damaged one, cannot be resumed from, so start over.
+            std::cout << error.what() << " Discarding it and starting a fresh search.\n";
+            checkpoint.discard();
+            search_pointer = make_search();
         }
+        auto& search = *search_pointer;
+
+        auto checkpoint_time = std::chrono::steady_clock::now();
+        while (search.resume(10000) == Resumable_Search::Status::running)
+        {
+            if (std::chrono::steady_clock::now() - checkpoint_time >= std::chrono::seconds(10))
+            {
+                checkpoint.save(search);
+                checkpoint_time = std::chrono::steady_clock::now();
+            }
+        }
+        checkpoint.discard();
+
+        generated = search.get_status() == Resumable_Search::Status::solved;
+        if (generated)
+            Crossword_Utils::print(std::cout, search.get_solution());
     }
 
     auto stop_time = std::chrono::high_resolution_clock::now();
     auto duration_s = std::chrono::duration_cast<std::chrono::seconds>(stop_time - start_time);
     auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time);
 
+    if (algorithm == "auto")
+    {
+        selection_log
+            << "puzzle=" << puzzle_directory
+            << " generated=" << generated << " ms=" << duration_ms.count()
+            << '\n';
+    }
+
     if (!generated)
     {
         std::cout << "No valid solution exists for the given puzzle in combination with the given dictionary.\n";
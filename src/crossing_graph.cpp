@@ -0,0 +1,104 @@
+#include "crossing_graph.h"
+
+#include <algorithm>
+#include <cctype>
+
+Crossing::Crossing(int slot_, int x_, int y_, int offset_, int crossing_offset_) :
+    slot(slot_),
+    y(y_),
+    x(x_),
+    offset(offset_),
+    crossing_offset(crossing_offset_)
+{}
+
+//! @brief Build the crossings of every slot in a single pass over the cells.
+//!        The crossings of slot i are crossings[offsets[i]] up to crossings[offsets[i + 1]].
+//! @param puzzle The crossword puzzle.
+//! @param entries All entries.
+Crossing_Graph::Crossing_Graph(const std::vector<std::vector<char>>& puzzle, const std::vector<Crossword_Entry>& entries) :
+    width(0)
+{
+    for (const auto& row : puzzle)
+        width = std::max(width, static_cast<int>(row.size()));
+
+    std::vector<int> entry_numbers(puzzle.size() * width, 0);
+    for (const auto& entry : entries)
+        entry_numbers[entry.y * width + entry.x] = entry.number;
+
+    auto is_white = [&](int x, int y)
+    {
+        return y >= 0 && x >= 0 && y < puzzle.size() && x < puzzle[y].size() && (puzzle[y][x] == ' ' || isalpha(puzzle[y][x]));
+    };
+
+    // Slots start at numbered cells, in reading order and across before down.
+    cell_slots.assign(puzzle.size() * width, { -1, -1 });
+    for (int y = 0; y < puzzle.size(); ++y)
+    {
+        for (int x = 0; x < puzzle[y].size(); ++x)
+        {
+            int number = entry_numbers[y * width + x];
+            if (number == 0)
+                continue;
+
+            if (!is_white(x - 1, y) && is_white(x + 1, y))
+            {
+                int length = 0;
+                while (is_white(x + length, y))
+                {
+                    cell_slots[y * width + x + length][0] = slots.size();
+                    ++length;
+                }
+                slots.emplace_back(number, x, y, 'a', length);
+            }
+
+            if (!is_white(x, y - 1) && is_white(x, y + 1))
+            {
+                int length = 0;
+                while (is_white(x, y + length))
+                {
+                    cell_slots[(y + length) * width + x][1] = slots.size();
+                    ++length;
+                }
+                slots.emplace_back(number, x, y, 'd', length);
+            }
+        }
+    }
+
+    offsets.reserve(slots.size() + 1);
+    for (int i = 0; i < slots.size(); ++i)
+    {
+        offsets.push_back(crossings.size());
+
+        const auto& slot = slots[i];
+        int direction = slot.direction == 'a' ? 0 : 1;
+        int x = slot.x, y = slot.y;
+        for (int j = 0; j < slot.length; ++j)
+        {
+            int crossing = cell_slots[y * width + x][1 - direction];
+            if (crossing != -1)
+            {
+                int crossing_offset = direction == 0 ? y - slots[crossing].y : x - slots[crossing].x;
+                crossings.emplace_back(crossing, x, y, j, crossing_offset);
+            }
+
+            if (direction == 0)
+                ++x;
+            else
+                ++y;
+        }
+    }
+    offsets.push_back(crossings.size());
+}
+
+//! @brief Get the slot covering a cell in a direction.
+//! @param x The x coordinate of the cell.
+//! @param y The y coordinate of the cell.
+//! @param direction The direction of the slot (across/down).
+//! @return The index of the slot, or -1 if no slot covers the cell in that direction.
+int Crossing_Graph::get_slot(int x, int y, char direction) const
+{
+    if (y < 0 || x < 0 || x >= width || y * width + x >= cell_slots.size())
+        return -1;
+
+    return cell_slots[y * width + x][direction == 'a' ? 0 : 1];
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "crossword_entry.h"
+#include "crossword_slot.h"
+
+#include <array>
+#include <vector>
+
+struct Crossing
+{
+    Crossing(int, int, int, int, int);
+
+    int slot;
+    int y, x;
+    int offset;
+    int crossing_offset;
+};
+
+struct Crossing_Graph
+{
+    Crossing_Graph(const std::vector<std::vector<char>>&, const std::vector<Crossword_Entry>&);
+
+    int get_slot(int, int, char) const;
+
+    std::vector<Crossword_Slot> slots;
+    std::vector<int> offsets;
+    std::vector<Crossing> crossings;
+
+    private:
+        int width;
+        std::vector<std::array<int, 2>> cell_slots;
+};
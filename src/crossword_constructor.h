@@ -1,316 +1,384 @@
 #pragma once
 
-#include "crossword_entry.h"
 #include "crossword_utils.h"
-#include "mrv_heuristic.h"
-#include "lcv_heuristic.h"
-#include "forward_checking_data.h"
+#include "crossing_graph.h"
+#include "resumable_search.h"
+#include "search_statistics.h"
+#include "search_strategies.h"
+#include "wdeg_heuristic.h"
+#include "word_index.h"
+#include "grid_features.h"
+#include "tree_decomposition.h"
+#include "tree_decomposition_solver.h"
+#include "local_search.h"
 
 #include <vector>
 #include <unordered_map>
-#include <optional>
-#include <cctype>
 #include <iostream>
-#include <type_traits>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <thread>
 
 class Crossword_Constructor
 {
     public:
         Crossword_Constructor() = delete;
-        Crossword_Constructor(const std::vector<std::vector<char>>&, const std::vector<Crossword_Entry>&, const std::unordered_map<int, std::vector<std::string>>&);
+        Crossword_Constructor(const std::unordered_map<int, std::vector<std::string>>&);
 
-        bool construct_via_backtracking(const std::vector<std::vector<char>>&);
-        bool construct_via_backtracking(std::vector<std::vector<char>>, std::size_t, std::vector<char>);
+        bool construct_via_backtracking(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&);
+        bool construct_via_mrv(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&);
+        bool construct_via_lcv(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&);
+        bool construct_via_mrv_and_fc(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&);
+        bool construct_via_wdeg(const std::vector<std::vector<char>>&, const Word_Index&, WDEG_Heuristic&);
+        bool construct_via_tree_decomposition(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&);
+        bool construct_via_local_search(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&, unsigned);
+        bool construct_via_auto(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&, std::ostream&);
 
-        bool construct_via_mrv(std::vector<std::vector<char>>);
-        bool construct_via_lcv(std::vector<std::vector<char>>, std::unordered_map<int, Constraints>&);
-        bool construct_via_mrv_and_fc(std::vector<std::vector<char>>, Forward_Checking_Data&);
+        static std::unique_ptr<Search_Strategy> make_strategy(const std::string&, const Crossing_Graph&, const Word_Index&, WDEG_Heuristic&);
+
+        Search_Statistics statistics;
 
     private:
-        std::vector<std::vector<char>> puzzle;
-        std::vector<Crossword_Entry> entries;
+        bool construct(Resumable_Search&, const Crossing_Graph&, const Word_Index&);
+        bool report(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&);
+
         std::unordered_map<int, std::vector<std::string>> constrained_words;
+        bool invalid_fill = false;
 };
 
-Crossword_Constructor::Crossword_Constructor(const std::vector<std::vector<char>>& puzzle_, const std::vector<Crossword_Entry>& entries_, const std::unordered_map<int, std::vector<std::string>>& constrained_words_) :
-    puzzle(puzzle_),
-    entries(entries_),
+Crossword_Constructor::Crossword_Constructor(const std::unordered_map<int, std::vector<std::string>>& constrained_words_) :
     constrained_words(constrained_words_)
 {}
 
 //! @brief Generate a crossword puzzle via backtracking with no heuristics involved.
 //! @param puzzle The puzzle to fill.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
 //! @return True if the puzzle frame was fillable, false otherwise.
-bool Crossword_Constructor::construct_via_backtracking(const std::vector<std::vector<char>>& puzzle)
+bool Crossword_Constructor::construct_via_backtracking(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph& crossing_graph, const Word_Index& word_index)
 {
-    return construct_via_backtracking(puzzle, 0, { });
+    Resumable_Search search(puzzle, crossing_graph, word_index, std::make_unique<Backtracking_Strategy>(crossing_graph, word_index));
+    return construct(search, crossing_graph, word_index);
 }
 
-//! @brief Generate a crossword puzzle via backtracking with no heuristics involved.
-//! @param solution The puzzle filled with an intermediary solution amidst the backtracking route.
-//! @param entry_index Index of the puzzle word entry to use.
-//! @param directions The supported directions of the puzzle word entry.
+//! @brief Generate a crossword puzzle via backtracking using the MRV heuristic.
+//! @param puzzle The puzzle to fill.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
 //! @return True if the puzzle frame was fillable, false otherwise.
-bool Crossword_Constructor::construct_via_backtracking(
-    std::vector<std::vector<char>> solution,
-    std::size_t entry_index,
-    std::vector<char> directions)
+bool Crossword_Constructor::construct_via_mrv(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph& crossing_graph, const Word_Index& word_index)
 {
-    if (Crossword_Utils::is_full(solution))
-    {
-        Crossword_Utils::print(std::cout, solution);
-        return true;
-    }
-
-    auto entry = entries[entry_index];
-    int y = entry.y, x = entry.x;
-
-    if (directions.empty())
-        directions = Crossword_Utils::get_entry_directions(puzzle, x, y);
-
-    char direction = directions.back();
-    directions.pop_back();
+    Resumable_Search search(puzzle, crossing_graph, word_index, std::make_unique<MRV_Strategy>(crossing_graph, word_index));
+    return construct(search, crossing_graph, word_index);
+}
 
-    if (directions.empty())
-        ++entry_index;
+//! @brief Generate a crossword puzzle via backtracking using the LCV heuristic.
+//! @param puzzle The puzzle to fill.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+//! @return True if the puzzle frame was fillable, false otherwise.
+bool Crossword_Constructor::construct_via_lcv(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph& crossing_graph, const Word_Index& word_index)
+{
+    Resumable_Search search(puzzle, crossing_graph, word_index, std::make_unique<LCV_Strategy>(crossing_graph, word_index));
+    return construct(search, crossing_graph, word_index);
+}
 
-    int entry_length = Crossword_Utils::get_entry_length(puzzle, x, y, direction);
+//! @brief Generate a crossword puzzle via backtracking using the MRV heuristic and forward checking.
+//! @param puzzle The puzzle to fill.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+//! @return True if the puzzle frame was fillable, false otherwise.
+bool Crossword_Constructor::construct_via_mrv_and_fc(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph& crossing_graph, const Word_Index& word_index)
+{
+    Resumable_Search search(puzzle, crossing_graph, word_index, std::make_unique<Forward_Checking_Strategy>(crossing_graph, word_index));
+    return construct(search, crossing_graph, word_index);
+}
 
-    for (const auto& word : constrained_words[entry_length])
+//! @brief Generate a crossword puzzle via backtracking using the dom/wdeg heuristic, restarting with a growing failure limit.
+//!        Crossing weights learned before a restart are kept, so every restart tackles the hardest region earlier.
+//! @param puzzle The puzzle to fill.
+//! @param word_index The dictionary indexed by letter position.
+//! @param heuristic The crossing weights.
+//! @return True if the puzzle frame was fillable, false otherwise.
+bool Crossword_Constructor::construct_via_wdeg(const std::vector<std::vector<char>>& puzzle, const Word_Index& word_index, WDEG_Heuristic& heuristic)
+{
+    for (std::size_t failure_limit = heuristic.restart_failures;; failure_limit += failure_limit / 2)
     {
-        bool finished_word = true;
-        std::vector<std::pair<int, int>> revert_on_fail;
-        for (auto c : word)
-        {
-            if (isalpha(solution[y][x]) && solution[y][x] != c)
-            {
-                finished_word = false;
-                break;
-            }
-
-            if (solution[y][x] == ' ')
-            {
-                solution[y][x] = c;
-                revert_on_fail.emplace_back(y, x);
-            }
-
-            if (direction == 'a')
-                ++x;
-            else
-                ++y;
-        }
-
-        if (finished_word)
-        {
-            if (construct_via_backtracking(solution, entry_index, directions))
-                return true;
-        }
-
-        while (!revert_on_fail.empty())
-        {
-            auto [y, x] = revert_on_fail.back();
-            revert_on_fail.pop_back();
-
-            solution[y][x] = ' ';
-        }
-
-        y = entry.y;
-        x = entry.x;
+        heuristic.failures = 0;
+        Resumable_Search search(puzzle, heuristic.crossing_graph, word_index, std::make_unique<WDEG_Strategy>(word_index, heuristic));
+        search.statistics = statistics;
+
+        // Place one word at a time, so the search gives up for a restart as soon as it passes the failure limit.
+        auto status = Resumable_Search::Status::running;
+        while (status == Resumable_Search::Status::running && heuristic.failures <= failure_limit && !search.statistics.out_of_budget())
+            status = search.resume(1);
+
+        statistics = search.statistics;
+        if (status == Resumable_Search::Status::solved)
+            return report(search.get_solution(), heuristic.crossing_graph, word_index);
+
+        // The search space was exhausted without hitting the limit.
+        if (heuristic.failures <= failure_limit || statistics.out_of_budget())
+            return false;
     }
-
-    return false;
 }
 
-//! @brief Generate a crossword puzzle via backtracking using the MRV heuristic.
-//! @param solution The puzzle filled with an intermediary solution amidst the backtracking route.
+//! @brief Generate a crossword puzzle by solving a tree decomposition of the crossing graph cluster by cluster.
+//! @param puzzle The puzzle to fill.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
 //! @return True if the puzzle frame was fillable, false otherwise.
-bool Crossword_Constructor::construct_via_mrv(std::vector<std::vector<char>> solution)
+bool Crossword_Constructor::construct_via_tree_decomposition(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph& crossing_graph, const Word_Index& word_index)
 {
-    if (Crossword_Utils::is_full(solution))
-    {
-        Crossword_Utils::print(std::cout, solution);
-        return true;
-    }
+    Tree_Decomposition decomposition(crossing_graph);
+    std::cerr << "Tree decomposition: " << decomposition.bags.size() << " clusters of width " << decomposition.width << '\n';
+
+    Tree_Decomposition_Solver solver(crossing_graph, decomposition, word_index, statistics);
+    auto solution = solver.solve(puzzle);
+    if (!solution)
+        return false;
 
-    auto [entry_index, direction] = MRV_Heuristic::perform(solution, entries, constrained_words);
-    auto entry = entries[entry_index];
-    int x = entry.x, y = entry.y;
-    int entry_length = Crossword_Utils::get_entry_length(puzzle, x, y, direction);
+    Crossword_Utils::print(std::cout, *solution);
+    return true;
+}
 
-    for (const auto& word : constrained_words[entry_length])
+//! @brief Generate a crossword puzzle by local search, running independently seeded searches on several threads.
+//!        Every search repairs a complete but conflicting assignment; the first one to remove every conflict stops the others.
+//!        Local search cannot prove a puzzle unfillable, so it only gives up once the deadline of the statistics passes.
+//! @param puzzle The puzzle to fill.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+//! @param thread_count The number of searches to run at once.
+//! @return True if the puzzle frame was filled, false otherwise.
+bool Crossword_Constructor::construct_via_local_search(
+    const std::vector<std::vector<char>>& puzzle,
+    const Crossing_Graph& crossing_graph,
+    const Word_Index& word_index,
+    unsigned thread_count)
+{
+    std::atomic<bool> solved(false);
+    std::atomic<std::size_t> steps(0);
+    std::optional<std::vector<std::vector<char>>> solution;
+    std::mutex solution_mutex;
+
+    std::random_device seeds;
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < std::max(thread_count, 1u); ++i)
     {
-        bool finished_word = true;
-        std::vector<std::pair<int, int>> revert_on_fail;
-        for (auto c : word)
+        threads.emplace_back([&, seed = seeds()]()
         {
-            if (isalpha(solution[y][x]) && solution[y][x] != c)
+            Local_Search search(puzzle, crossing_graph, word_index, seed);
+            if (search.run(solved, statistics.deadline) && !solved.exchange(true))
             {
-                finished_word = false;
-                break;
+                std::lock_guard<std::mutex> lock(solution_mutex);
+                solution = search.get_solution();
             }
+            steps += search.steps;
+        });
+    }
 
-            if (solution[y][x] == ' ')
-            {
-                solution[y][x] = c;
-                revert_on_fail.emplace_back(y, x);
-            }
-
-            if (direction == 'a')
-                ++x;
-            else
-                ++y;
-        }
-
-        if (finished_word)
-        {
-            if (construct_via_mrv(solution))
-                return true;
-        }
-
-        while (!revert_on_fail.empty())
-        {
-            auto [y, x] = revert_on_fail.back();
-            revert_on_fail.pop_back();
-
-            solution[y][x] = ' ';
-        }
+    for (auto& thread : threads)
+        thread.join();
 
-        y = entry.y;
-        x = entry.x;
-    }
+    statistics.nodes += steps;
+    if (!solution)
+        return false;
 
-    return false;
+    Crossword_Utils::print(std::cout, *solution);
+    return true;
 }
 
-//! @brief Generate a crossword puzzle via backtracking using the LCV heuristic.
-//! @param solution The puzzle filled with an intermediary solution amidst the backtracking route.
+//! @brief Generate a crossword puzzle with the algorithm predicted to need the least effort.
+//!        Every algorithm is probed under a fixed node budget. A probe that solves or exhausts the puzzle settles it;
+//!        otherwise the size of every algorithm's search tree is estimated from a fixed number of Knuth samples with a
+//!        fixed seed, and the algorithm with the smallest tree is run. No wall clock enters the decision, so it can be
+//!        reproduced from the log. A probe whose fill holds a word outside the dictionary rules its algorithm out.
+//!        The grid features, the probes and the decision are written to the log as key=value pairs on one line,
+//!        which is flushed before the chosen algorithm runs.
+//! @param puzzle The puzzle to fill.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+//! @param log Output stream receiving the selection record.
 //! @return True if the puzzle frame was fillable, false otherwise.
-bool Crossword_Constructor::construct_via_lcv(std::vector<std::vector<char>> solution, std::unordered_map<int, Constraints>& constraints)
+bool Crossword_Constructor::construct_via_auto(
+    const std::vector<std::vector<char>>& puzzle,
+    const Crossing_Graph& crossing_graph,
+    const Word_Index& word_index,
+    std::ostream& log)
 {
-    if (Crossword_Utils::is_full(solution))
+    constexpr std::size_t probe_nodes = 5000;
+    constexpr std::size_t tree_samples = 32;
+    constexpr unsigned sample_seed = 1;
+
+    Grid_Features features(puzzle, crossing_graph, word_index);
+    log << features;
+    if (features.min_domain == 0)
     {
-        Crossword_Utils::print(std::cout, solution);
-        return true;
+        log << " choice=none reason=slot_length_without_words" << std::endl;
+        return false;
     }
 
-    auto [entry_index, direction] = LCV_Heuristic::perform(solution, entries, constrained_words, constraints);
-    auto entry = entries[entry_index];
-    int x = entry.x, y = entry.y;
-    int entry_length = Crossword_Utils::get_entry_length(puzzle, x, y, direction);
+    WDEG_Heuristic heuristic(crossing_graph);
+    heuristic.restart_failures = std::max<std::size_t>(100, 2 * features.slots);
 
-    for (const auto& word : constrained_words[entry_length])
+    // The weights stay at 1 while sampling, so every sample follows the tree of wdeg's first run.
+    WDEG_Heuristic sampled_heuristic(crossing_graph);
+    sampled_heuristic.learning = false;
+
+    auto run = [&](const std::string& algorithm)
+    {
+        if (algorithm == "standard-backtracking")
+            return construct_via_backtracking(puzzle, crossing_graph, word_index);
+        if (algorithm == "mrv")
+            return construct_via_mrv(puzzle, crossing_graph, word_index);
+        if (algorithm == "lcv")
+            return construct_via_lcv(puzzle, crossing_graph, word_index);
+        if (algorithm == "fc+mrv")
+            return construct_via_mrv_and_fc(puzzle, crossing_graph, word_index);
+
+        return construct_via_wdeg(puzzle, word_index, heuristic);
+    };
+
+    std::string choice;
+    double best_tree_size = std::numeric_limits<double>::infinity();
+    for (const std::string algorithm : { "standard-backtracking", "mrv", "lcv", "fc+mrv", "wdeg" })
     {
-        bool finished_word = true;
-        std::vector<std::pair<int, int>> revert_on_fail;
-        for (auto c : word)
+        auto start_time = std::chrono::steady_clock::now();
+        statistics = Search_Statistics();
+        statistics.node_limit = probe_nodes;
+        invalid_fill = false;
+
+        bool generated = run(algorithm);
+        bool out_of_budget = statistics.out_of_budget();
+        auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+
+        log
+            << " probe[" << algorithm << "]="
+            << "nodes:" << statistics.nodes
+            << ",failures:" << statistics.failures
+            << ",max_depth:" << statistics.max_depth
+            << ",us:" << duration_us.count()
+            << ",invalid_fill:" << invalid_fill;
+
+        // An algorithm that passed off a grid with a non-word as a fill can neither settle the puzzle nor be chosen.
+        if (invalid_fill)
+            continue;
+
+        if (generated || !out_of_budget)
         {
-            if (isalpha(solution[y][x]) && solution[y][x] != c)
-            {
-                finished_word = false;
-                break;
-            }
-
-            if (solution[y][x] == ' ')
-            {
-                solution[y][x] = c;
-                revert_on_fail.emplace_back(y, x);
-            }
-
-            if (direction == 'a')
-                ++x;
-            else
-                ++y;
+            log << " choice=" << algorithm << " reason=" << (generated ? "solved_by_probe" : "exhausted_by_probe") << std::endl;
+            return generated;
         }
 
-        if (finished_word)
-        {
-            if (construct_via_lcv(solution, constraints))
-                return true;
-        }
+        std::mt19937 random(sample_seed);
+        Resumable_Search sampled_search(puzzle, crossing_graph, word_index, make_strategy(algorithm, crossing_graph, word_index, sampled_heuristic));
+        double tree_size = 0.0;
+        for (std::size_t i = 0; i < tree_samples; ++i)
+            tree_size += sampled_search.sample_tree_size(random) / tree_samples;
 
-        while (!revert_on_fail.empty())
+        log << ",estimated_nodes:" << tree_size;
+        if (tree_size < best_tree_size)
         {
-            auto [y, x] = revert_on_fail.back();
-            revert_on_fail.pop_back();
-
-            solution[y][x] = ' ';
+            choice = algorithm;
+            best_tree_size = tree_size;
         }
+    }
 
-        y = entry.y;
-        x = entry.x;
+    if (choice.empty())
+    {
+        log << " choice=none reason=no_valid_probe" << std::endl;
+        return false;
     }
 
-    return false;
+    log << " choice=" << choice << " reason=smallest_estimate";
+    if (choice == "wdeg")
+        log << " restart_failures=" << heuristic.restart_failures;
+    log << std::endl;
+
+    std::cout << "Selected algorithm: " << choice << '\n';
+
+    statistics = Search_Statistics();
+    return run(choice);
 }
 
-//! @brief Generate a crossword puzzle via backtracking using the MRV heuristic and forward checking.
-//! @param solution The puzzle filled with an intermediary solution amidst the backtracking route.
+//! @brief Create the slot ordering and propagation of a backtracking algorithm.
+//! @param algorithm The algorithm: standard-backtracking, mrv, lcv, fc+mrv or wdeg.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+//! @param heuristic The crossing weights, used by wdeg only.
+//! @return The strategy.
+std::unique_ptr<Search_Strategy> Crossword_Constructor::make_strategy(
+    const std::string& algorithm,
+    const Crossing_Graph& crossing_graph,
+    const Word_Index& word_index,
+    WDEG_Heuristic& heuristic)
+{
+    if (algorithm == "standard-backtracking")
+        return std::make_unique<Backtracking_Strategy>(crossing_graph, word_index);
+    if (algorithm == "mrv")
+        return std::make_unique<MRV_Strategy>(crossing_graph, word_index);
+    if (algorithm == "lcv")
+        return std::make_unique<LCV_Strategy>(crossing_graph, word_index);
+    if (algorithm == "fc+mrv")
+        return std::make_unique<Forward_Checking_Strategy>(crossing_graph, word_index);
+    if (algorithm == "wdeg")
+        return std::make_unique<WDEG_Strategy>(word_index, heuristic);
+
+    throw std::runtime_error("Unknown backtracking algorithm " + algorithm + ".");
+}
+
+//! @brief Run a search until it is solved, exhausted or out of budget, carrying the statistics over from earlier runs.
+//! @param search The search to run.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
 //! @return True if the puzzle frame was fillable, false otherwise.
-bool Crossword_Constructor::construct_via_mrv_and_fc(std::vector<std::vector<char>> solution, Forward_Checking_Data& checked_words)
+bool Crossword_Constructor::construct(Resumable_Search& search, const Crossing_Graph& crossing_graph, const Word_Index& word_index)
 {
-    if (Crossword_Utils::is_full(solution))
-    {
-        Crossword_Utils::print(std::cout, solution);
-        return true;
-    }
+    search.statistics = statistics;
+    auto status = search.resume(std::numeric_limits<std::size_t>::max());
+    statistics = search.statistics;
 
-    auto [entry_index, direction] = MRV_Heuristic::perform(solution, entries, constrained_words);
-    auto entry = entries[entry_index];
-    int x = entry.x, y = entry.y;
-    int entry_length = Crossword_Utils::get_entry_length(puzzle, x, y, direction);
+    if (status != Resumable_Search::Status::solved)
+        return false;
+
+    return report(search.get_solution(), crossing_graph, word_index);
+}
 
-    const auto& eligible_words = checked_words.eligible_words.at(entry.number);
-    for (const auto& word : eligible_words)
+//! @brief Print a filled puzzle, after checking that every slot holds a dictionary word.
+//!        A fill failing the check is not printed and sets invalid_fill, so that construct_via_auto never trusts it.
+//! @param solution The filled puzzle.
+//! @param crossing_graph The slots of the puzzle.
+//! @param word_index The dictionary indexed by letter position.
+//! @return True if the fill is valid, false otherwise.
+bool Crossword_Constructor::report(const std::vector<std::vector<char>>& solution, const Crossing_Graph& crossing_graph, const Word_Index& word_index)
+{
+    for (const auto& slot : crossing_graph.slots)
     {
-        bool finished_word = true;
-        std::vector<std::pair<int, int>> revert_on_fail;
-        std::vector<std::pair<int, std::string>> eliminated_words;
-        for (auto c : word)
+        std::string word;
+        int x = slot.x, y = slot.y;
+        for (int i = 0; i < slot.length; ++i)
         {
-            if (isalpha(solution[y][x]) && solution[y][x] != c)
-            {
-                finished_word = false;
-                break;
-            }
-
-            if (solution[y][x] == ' ')
-            {
-                solution[y][x] = c;
-                revert_on_fail.emplace_back(y, x);
-            }
-
-
-            if (direction == 'a')
+            word.push_back(solution[y][x]);
+            if (slot.direction == 'a')
                 ++x;
             else
                 ++y;
         }
 
-        if (finished_word)
-        {
-            eliminated_words = checked_words.eliminate_words(solution, word, entry.number, entry.x, entry.y, direction, entries);
-            if (construct_via_mrv_and_fc(solution, checked_words))
-                return true;
-        }
-
-        while (!revert_on_fail.empty())
+        if (!word_index.contains(word))
         {
-            auto [y, x] = revert_on_fail.back();
-            revert_on_fail.pop_back();
-
-            solution[y][x] = ' ';
+            invalid_fill = true;
+            return false;
         }
-
-        if (!eliminated_words.empty())
-        {
-            checked_words.add_words(eliminated_words);
-            eliminated_words.clear();
-        }
-
-        y = entry.y;
-        x = entry.x;
     }
 
-    return false;
+    Crossword_Utils::print(std::cout, solution);
+    return true;
 }
-
@@ -0,0 +1,9 @@
+#include "crossword_slot.h"
+
+Crossword_Slot::Crossword_Slot(int number_, int x_, int y_, char direction_, int length_) :
+    number(number_),
+    y(y_),
+    x(x_),
+    direction(direction_),
+    length(length_)
+{}
@@ -0,0 +1,11 @@
+#pragma once
+
+struct Crossword_Slot
+{
+    Crossword_Slot(int, int, int, char, int);
+
+    int number;
+    int y, x;
+    char direction;
+    int length;
+};
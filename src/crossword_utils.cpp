@@ -89,7 +89,7 @@ int Crossword_Utils::get_entry_length(const std::vector<std::vector<char>>& puzz
     }
     else if (direction == 'd')
     {
-        while (y < puzzle.size() && (puzzle[y][x] == ' ' || isalpha(puzzle[y][x])))
+        while (y < puzzle.size() && x < puzzle[y].size() && (puzzle[y][x] == ' ' || isalpha(puzzle[y][x])))
         {
             ++length;
             ++y;
@@ -109,12 +109,74 @@ std::vector<char> Crossword_Utils::get_entry_directions(const std::vector<std::v
     std::vector<char> directions;
     if ((x - 1 < 0 || puzzle[y][x - 1] == '#') && x + 1 < puzzle[y].size() && (puzzle[y][x + 1] == ' ' || isalpha(puzzle[y][x + 1])))
         directions.push_back('a');
-    if ((y - 1 < 0 || puzzle[y - 1][x] == '#') && y + 1 < puzzle.size() && (puzzle[y + 1][x] == ' ' || isalpha(puzzle[y + 1][x])))
+    if ((y - 1 < 0 || x >= puzzle[y - 1].size() || puzzle[y - 1][x] == '#') && y + 1 < puzzle.size() && x < puzzle[y + 1].size() && (puzzle[y + 1][x] == ' ' || isalpha(puzzle[y + 1][x])))
         directions.push_back('d');
 
     return directions;
 }
 
+//! @brief Number the word entries of a puzzle frame in reading order.
+//! @param puzzle The crossword puzzle.
+//! @return Every cell that starts an across and/or down entry, numbered from 1.
+std::vector<Crossword_Entry> Crossword_Utils::number_entries(const std::vector<std::vector<char>>& puzzle)
+{
+    std::vector<Crossword_Entry> entries;
+    for (int y = 0; y < puzzle.size(); ++y)
+    {
+        for (int x = 0; x < puzzle[y].size(); ++x)
+        {
+            if (puzzle[y][x] == '#')
+                continue;
+
+            if (!get_entry_directions(puzzle, x, y).empty())
+                entries.emplace_back(entries.size() + 1, x, y);
+        }
+    }
+
+    return entries;
+}
+
+//! @brief Expand the puzzle word entries into one slot per direction.
+//! @param puzzle The crossword puzzle.
+//! @param entries All entries.
+//! @return Every across and down slot of the puzzle.
+std::vector<Crossword_Slot> Crossword_Utils::get_slots(const std::vector<std::vector<char>>& puzzle, const std::vector<Crossword_Entry>& entries)
+{
+    std::vector<Crossword_Slot> slots;
+    for (const auto& entry : entries)
+    {
+        for (auto direction : get_entry_directions(puzzle, entry.x, entry.y))
+            slots.emplace_back(entry.number, entry.x, entry.y, direction, get_entry_length(puzzle, entry.x, entry.y, direction));
+    }
+
+    return slots;
+}
+
+//! @brief Check if a word agrees with the letters already placed in a slot.
+//! @param puzzle The crossword puzzle.
+//! @param slot The slot to check against.
+//! @param word The candidate word.
+//! @return True if the word has the slot's length and matches every filled cell, false otherwise.
+bool Crossword_Utils::word_fits(const std::vector<std::vector<char>>& puzzle, const Crossword_Slot& slot, const std::string& word)
+{
+    if (word.length() != slot.length)
+        return false;
+
+    int x = slot.x, y = slot.y;
+    for (auto c : word)
+    {
+        if (puzzle[y][x] != ' ' && puzzle[y][x] != c)
+            return false;
+
+        if (slot.direction == 'a')
+            ++x;
+        else
+            ++y;
+    }
+
+    return true;
+}
+
 //! @brief Check if every empty cell in the puzzle is filled.
 //! @param puzzle The crossword puzzle.
 //! @return True if the puzzle is filled, false otherwise.
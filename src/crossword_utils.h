@@ -1,6 +1,7 @@
 #pragma once
 
 #include "crossword_entry.h"
+#include "crossword_slot.h"
 
 #include <ostream>
 #include <string>
@@ -16,6 +17,9 @@ struct Crossword_Utils
     static std::unordered_map<int, std::vector<std::string>> get_constrained_words(const std::string&);
     static int get_entry_length(const std::vector<std::vector<char>>&, int, int, char);
     static std::vector<char> get_entry_directions(const std::vector<std::vector<char>>&, int, int);
+    static std::vector<Crossword_Entry> number_entries(const std::vector<std::vector<char>>&);
+    static std::vector<Crossword_Slot> get_slots(const std::vector<std::vector<char>>&, const std::vector<Crossword_Entry>&);
+    static bool word_fits(const std::vector<std::vector<char>>&, const Crossword_Slot&, const std::string&);
     static bool is_full(const std::vector<std::vector<char>>&);
     static bool is_full(const std::vector<std::vector<char>>&, int, int, char);
     static void print(std::ostream&, const std::vector<std::vector<char>>&);
@@ -1,96 +1,120 @@
 #include "forward_checking_data.h"
 
-#include "crossword_utils.h"
+//! @brief Create the eligible words of every slot.
+//!        A slot without eligible words of its own shares the dictionary's word list of its length,
+//!        so no word list is copied per slot.
+//! @param crossing_graph_ The crossings of every slot.
+//! @param word_index_ The dictionary indexed by letter position.
+Forward_Checking_Data::Forward_Checking_Data(const Crossing_Graph& crossing_graph_, const Word_Index& word_index_) :
+    crossing_graph(crossing_graph_),
+    word_index(word_index_),
+    assigned(crossing_graph_.slots.size(), false),
+    eligible_words(crossing_graph_.slots.size())
+{}
 
-#include <algorithm>
-
-//! @brief Create a mapping of entries to the respective words of appropriate length.
-Forward_Checking_Data::Forward_Checking_Data(
-    const std::unordered_map<int, Constraints>& _constraints,
-    const std::vector<std::vector<char>>& puzzle,
-    const std::vector<Crossword_Entry>& entries,
-    const std::unordered_map<int, std::vector<std::string>>& constrained_words) :
-        constraints(_constraints)
+//! @brief Keep only the words fitting the letters a puzzle already holds, for puzzles that start partly filled.
+//!        The restriction is permanent, so it is not recorded on the trail.
+//! @param puzzle The crossword puzzle.
+void Forward_Checking_Data::restrict_to_letters(const std::vector<std::vector<char>>& puzzle)
 {
-    for (const auto& entry : entries)
+    for (int i = 0; i < crossing_graph.slots.size(); ++i)
     {
-        auto entry_directions = Crossword_Utils::get_entry_directions(puzzle, entry.x, entry.y);
-        for (auto direction : entry_directions)
+        const auto& slot = crossing_graph.slots[i];
+        int x = slot.x, y = slot.y;
+        for (int j = 0; j < slot.length; ++j)
         {
-            auto entry_length = Crossword_Utils::get_entry_length(puzzle, entry.x, entry.y, direction);
-            auto words = constrained_words.at(entry_length);
-            eligible_words.emplace(entry.number, words);
+            if (puzzle[y][x] != ' ')
+            {
+                auto matching_words = word_index.get_words(slot.length, j, puzzle[y][x]);
+                auto& word_candidates = eligible_words[i];
+                word_candidates = word_candidates ? std::make_shared<const Roaring_Bitmap>(word_candidates->intersect(*matching_words)) : matching_words;
+            }
+
+            if (slot.direction == 'a')
+                ++x;
+            else
+                ++y;
         }
     }
 }
 
-//! @brief Eliminate eligible words proactively.
+//! @brief Eliminate the eligible words of the unassigned slots crossing a freshly filled slot.
 //! @param puzzle The crossword puzzle.
-//! @param used_word The word to check against.
-//! @param entry The entry number to check against.
-//! @param x The first position of the entry.
-//! @param y The first position of the entry.
-//! @param direction The direction of the entry.
-//! @param entries All entries.
-//! @return All eliminated words with their respective entry number.
-std::vector<std::pair<int, std::string>> Forward_Checking_Data::eliminate_words(const std::vector<std::vector<char>>& puzzle, const std::string& used_word, int entry, int x, int y, char direction, const std::vector<Crossword_Entry>& entries)
+//! @param slot_index The slot that was just filled.
+//! @return The trail mark to restore the eliminated words with.
+std::size_t Forward_Checking_Data::eliminate_words(const std::vector<std::vector<char>>& puzzle, int slot_index)
 {
-    std::vector<std::pair<int, std::string>> eliminated_words;
-    const auto& constraint = constraints.at(entry);
-    if (direction == 'a')
+    std::size_t trail_mark = get_trail_mark();
+    for (int i = crossing_graph.offsets[slot_index]; i < crossing_graph.offsets[slot_index + 1]; ++i)
     {
-        for (const auto& shared_entry : constraint.shared_entries_down)
-        {
-            auto entry_actual = std::find_if(entries.begin(), entries.end(), [&](const Crossword_Entry& entry_pred) { return entry_pred.number == entry; });
-            int position = y - entry_actual->y;
-            for (const auto& pos : shared_entry.second)
-            {
-                auto& word_candidates = eligible_words.at(entry);
-                auto it = word_candidates.begin();
-                while (it != word_candidates.end())
-                {
-                    if ((*it)[position] == puzzle[y][x])
-                    {
-                        eliminated_words.emplace_back(shared_entry.first, *it);
-                        it = word_candidates.erase(it);
-                    }
-                    else
-                        ++it;
-                }
-            }
-        }
+        const auto& crossing = crossing_graph.crossings[i];
+        if (assigned[crossing.slot])
+            continue;
+
+        auto matching_words = word_index.get_words(crossing_graph.slots[crossing.slot].length, crossing.crossing_offset, puzzle[crossing.y][crossing.x]);
+        auto& word_candidates = eligible_words[crossing.slot];
+        trail.emplace_back(crossing.slot, word_candidates);
+        if (word_candidates)
+            word_candidates = std::make_shared<const Roaring_Bitmap>(word_candidates->intersect(*matching_words));
+        else
+            word_candidates = matching_words;
+    }
+
+    return trail_mark;
+}
+
+//! @brief Mark the eliminations made so far.
+//! @return The trail mark to restore to.
+std::size_t Forward_Checking_Data::get_trail_mark() const
+{
+    return trail.size();
+}
+
+//! @brief Restore the eligible words eliminated since a trail mark.
+//! @param trail_mark The trail mark returned when eliminating the words.
+void Forward_Checking_Data::restore(std::size_t trail_mark)
+{
+    while (trail.size() > trail_mark)
+    {
+        eligible_words[trail.back().first] = std::move(trail.back().second);
+        trail.pop_back();
     }
-    else
+}
+
+//! @brief Check if an unassigned slot crossing a slot has run out of eligible words.
+//! @param slot_index The slot to check around.
+//! @return True if a crossing slot has no eligible word left, false otherwise.
+bool Forward_Checking_Data::wiped_out(int slot_index) const
+{
+    for (int i = crossing_graph.offsets[slot_index]; i < crossing_graph.offsets[slot_index + 1]; ++i)
     {
-        for (const auto& shared_entry : constraint.shared_entries_across)
-        {
-            auto entry_actual = std::find_if(entries.begin(), entries.end(), [&](const Crossword_Entry& entry_pred) { return entry_pred.number == entry; });
-            int position = x - entry_actual->x;
-            for (const auto& pos : shared_entry.second)
-            {
-                auto& word_candidates = eligible_words.at(entry);
-                auto it = word_candidates.begin();
-                while (it != word_candidates.end())
-                {
-                    if ((*it)[position] == puzzle[y][x])
-                    {
-                        eliminated_words.emplace_back(shared_entry.first, *it);
-                        it = word_candidates.erase(it);
-                    }
-                    else
-                        ++it;
-                }
-            }
-        }
+        const auto& crossing = crossing_graph.crossings[i];
+        if (!assigned[crossing.slot] && get_eligible_count(crossing.slot) == 0)
+            return true;
     }
 
-    return eliminated_words;
+    return false;
 }
 
-//! @brief Add words to the eligible words list.
-//! @param words Words to add.
-void Forward_Checking_Data::add_words(const std::vector<std::pair<int, std::string>>& words)
+//! @brief Get the number of eligible words of a slot.
+//! @param slot_index The slot.
+//! @return The number of eligible words.
+std::size_t Forward_Checking_Data::get_eligible_count(int slot_index) const
 {
-    for (const auto& word : words)
-        eligible_words.at(word.first).push_back(word.second);
+    const auto& word_candidates = eligible_words[slot_index];
+    return word_candidates ? word_candidates->cardinality() : word_index.get_word_count(crossing_graph.slots[slot_index].length);
+}
+
+//! @brief Get the next eligible word of a slot.
+//! @param slot_index The slot.
+//! @param from The word index to start from.
+//! @return The smallest eligible word index not less than from, or -1 if there is none.
+int Forward_Checking_Data::next_eligible_word(int slot_index, int from) const
+{
+    const auto& word_candidates = eligible_words[slot_index];
+    if (!word_candidates)
+        return from < word_index.get_word_count(crossing_graph.slots[slot_index].length) ? from : -1;
+
+    auto word = word_candidates->next(from);
+    return word ? static_cast<int>(*word) : -1;
 }
@@ -1,24 +1,29 @@
 #pragma once
 
-#include "crossword_entry.h"
-#include "constraints.h"
+#include "crossing_graph.h"
+#include "word_index.h"
 
-#include <unordered_map>
-#include <string>
+#include <memory>
 #include <vector>
 #include <utility>
 
 struct Forward_Checking_Data
 {
-    Forward_Checking_Data(
-        const std::unordered_map<int, Constraints>&,
-        const std::vector<std::vector<char>>&,
-        const std::vector<Crossword_Entry>&,
-        const std::unordered_map<int, std::vector<std::string>>&);
+    Forward_Checking_Data(const Crossing_Graph&, const Word_Index&);
 
-    std::vector<std::pair<int, std::string>> eliminate_words(const std::vector<std::vector<char>>&, const std::string&, int, int, int, char, const std::vector<Crossword_Entry>&);
-    void add_words(const std::vector<std::pair<int, std::string>>&);
+    void restrict_to_letters(const std::vector<std::vector<char>>&);
+    std::size_t eliminate_words(const std::vector<std::vector<char>>&, int);
+    std::size_t get_trail_mark() const;
+    void restore(std::size_t);
+    bool wiped_out(int) const;
+    std::size_t get_eligible_count(int) const;
+    int next_eligible_word(int, int) const;
 
-    std::unordered_map<int, std::vector<std::string>> eligible_words;
-    std::unordered_map<int, Constraints> constraints;
+    const Crossing_Graph& crossing_graph;
+    const Word_Index& word_index;
+    std::vector<bool> assigned;
+
+    private:
+        std::vector<std::shared_ptr<const Roaring_Bitmap>> eligible_words;
+        std::vector<std::pair<int, std::shared_ptr<const Roaring_Bitmap>>> trail;
 };
@@ -0,0 +1,354 @@
+#include "frame_generator.h"
+
+#include "crossword_utils.h"
+#include "crossing_graph.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+//! @brief Create a generator of symmetric square frames.
+//! @param size_ The width and height of the frames.
+//! @param black_squares_ The number of black squares in each frame.
+//! @param constrained_words_ Mapping of word length to dictionary words, used to pre-screen fillability.
+//! @param seed Seed of the random layout.
+Frame_Generator::Frame_Generator(int size_, int black_squares_, const std::unordered_map<int, std::vector<std::string>>& constrained_words_, unsigned int seed) :
+    size(size_),
+    black_squares(black_squares_),
+    constrained_words(constrained_words_),
+    random_engine(seed)
+{
+    if (size < 3)
+        throw std::runtime_error("Frames must be at least 3x3.");
+    if (black_squares < 0 || black_squares >= size * size)
+        throw std::runtime_error("Invalid number of black squares: " + std::to_string(black_squares));
+    if (black_squares % 2 == 1 && size % 2 == 0)
+        throw std::runtime_error("A symmetric frame of even size needs an even number of black squares.");
+
+    // Black squares never leave slots of one or two letters, so every slot has 3 to size letters.
+    bool has_slot_words = false;
+    for (int length = 3; length <= size; ++length)
+    {
+        auto words = constrained_words.find(length);
+        has_slot_words = has_slot_words || (words != constrained_words.end() && !words->second.empty());
+    }
+    if (!has_slot_words)
+        throw std::runtime_error("The dictionary has no words of 3 to " + std::to_string(size) + " letters.");
+
+    // The letters each position of each word length can hold, and the words holding each of them.
+    for (const auto& [length, words] : constrained_words)
+    {
+        auto& masks = letter_masks[length];
+        auto& postings = letter_postings[length];
+        masks.assign(length, 0);
+        postings.resize(length);
+        for (int word_index = 0; word_index < words.size(); ++word_index)
+        {
+            for (int i = 0; i < length; ++i)
+            {
+                int letter = letter_index(words[word_index][i]);
+                masks[i] |= 1u << letter;
+                postings[i][letter].push_back(word_index);
+            }
+        }
+    }
+}
+
+//! @brief Lay out one random candidate frame and screen it.
+//!        Callers should give up once consecutive_rejections reaches rejection_limit,
+//!        as the size, black square count and dictionary then most likely admit no frame at all.
+//! @return The frame if it is valid and passed the fillability pre-screen, nothing otherwise.
+std::optional<std::vector<std::vector<char>>> Frame_Generator::next_frame()
+{
+    ++candidates;
+    std::vector<std::vector<char>> frame(size, std::vector<char>(size, ' '));
+
+    int remaining = black_squares;
+    if (remaining % 2 == 1)
+    {
+        int center = size / 2;
+        frame[center][center] = '#';
+        --remaining;
+        if (creates_two_letter_slot(frame, center, center))
+        {
+            ++rejected_layouts;
+            ++consecutive_rejections;
+            return std::nullopt;
+        }
+    }
+
+    // Place black squares in pairs symmetric around the center, skipping any pair that would leave a two letter slot.
+    std::vector<int> cells((size * size) / 2);
+    std::iota(cells.begin(), cells.end(), 0);
+    std::shuffle(cells.begin(), cells.end(), random_engine);
+    for (auto cell : cells)
+    {
+        if (remaining == 0)
+            break;
+
+        int y = cell / size, x = cell % size;
+        int y_mirror = size - 1 - y, x_mirror = size - 1 - x;
+        frame[y][x] = '#';
+        frame[y_mirror][x_mirror] = '#';
+        if (creates_two_letter_slot(frame, y, x) || creates_two_letter_slot(frame, y_mirror, x_mirror))
+        {
+            frame[y][x] = ' ';
+            frame[y_mirror][x_mirror] = ' ';
+            continue;
+        }
+
+        remaining -= 2;
+    }
+
+    if (remaining > 0 || !is_connected(frame))
+    {
+        ++rejected_layouts;
+        ++consecutive_rejections;
+        return std::nullopt;
+    }
+
+    if (!is_fillable(frame))
+    {
+        ++rejected_fills;
+        ++consecutive_rejections;
+        return std::nullopt;
+    }
+
+    consecutive_rejections = 0;
+    return frame;
+}
+
+//! @brief Convert a frame into the puzzle file format, numbering every entry.
+//! @param frame The puzzle frame.
+//! @return The contents of a puzzle.txt file.
+std::string Frame_Generator::to_puzzle_text(const std::vector<std::vector<char>>& frame)
+{
+    auto entries = Crossword_Utils::number_entries(frame);
+    auto entry = entries.begin();
+
+    std::string text;
+    for (int y = 0; y < frame.size(); ++y)
+    {
+        for (int x = 0; x < frame[y].size(); ++x)
+        {
+            if (entry != entries.end() && entry->y == y && entry->x == x)
+            {
+                text += "[" + std::to_string(entry->number) + "]";
+                ++entry;
+            }
+            else
+            {
+                text += frame[y][x];
+            }
+        }
+        text += '\n';
+    }
+
+    return text;
+}
+
+//! @brief Check the row and column through a cell for slots of exactly two letters.
+//! @param frame The puzzle frame.
+//! @param y The row to check.
+//! @param x The column to check.
+//! @return True if the row or column holds a two letter slot, false otherwise.
+bool Frame_Generator::creates_two_letter_slot(const std::vector<std::vector<char>>& frame, int y, int x) const
+{
+    int run = 0;
+    for (int i = 0; i <= size; ++i)
+    {
+        if (i < size && frame[y][i] != '#')
+        {
+            ++run;
+            continue;
+        }
+
+        if (run == 2)
+            return true;
+        run = 0;
+    }
+
+    for (int i = 0; i <= size; ++i)
+    {
+        if (i < size && frame[i][x] != '#')
+        {
+            ++run;
+            continue;
+        }
+
+        if (run == 2)
+            return true;
+        run = 0;
+    }
+
+    return false;
+}
+
+//! @brief Check that every white cell of a frame can be reached from every other white cell.
+//! @param frame The puzzle frame.
+//! @return True if the white area is connected, false otherwise.
+bool Frame_Generator::is_connected(const std::vector<std::vector<char>>& frame) const
+{
+    std::vector<std::pair<int, int>> stack;
+    std::vector<std::vector<bool>> visited(size, std::vector<bool>(size, false));
+    for (int i = 0; i < size * size && stack.empty(); ++i)
+    {
+        if (frame[i / size][i % size] != '#')
+        {
+            stack.emplace_back(i / size, i % size);
+            visited[i / size][i % size] = true;
+        }
+    }
+
+    int reached = 0;
+    while (!stack.empty())
+    {
+        auto [y, x] = stack.back();
+        stack.pop_back();
+        ++reached;
+
+        const std::pair<int, int> neighbours[] = { { y - 1, x }, { y + 1, x }, { y, x - 1 }, { y, x + 1 } };
+        for (auto [ny, nx] : neighbours)
+        {
+            if (ny < 0 || ny >= size || nx < 0 || nx >= size || visited[ny][nx] || frame[ny][nx] == '#')
+                continue;
+
+            visited[ny][nx] = true;
+            stack.emplace_back(ny, nx);
+        }
+    }
+
+    return reached == size * size - black_squares;
+}
+
+//! @brief Cheaply reject frames the dictionary cannot fill.
+//!        Fails on slot lengths without words, on crossings whose positions share no letter,
+//!        and on slots left without words after a few rounds of letter propagation.
+//! @param frame The puzzle frame.
+//! @return False if the frame is certainly unfillable, true if it may be fillable.
+bool Frame_Generator::is_fillable(const std::vector<std::vector<char>>& frame) const
+{
+    Crossing_Graph crossing_graph(frame, Crossword_Utils::number_entries(frame));
+    const auto& slots = crossing_graph.slots;
+
+    std::vector<std::vector<unsigned int>> masks;
+    for (const auto& slot : slots)
+    {
+        auto length_masks = letter_masks.find(slot.length);
+        if (length_masks == letter_masks.end())
+            return false;
+
+        masks.push_back(length_masks->second);
+    }
+
+    // Each crossing once, as (across slot, offset, down slot, offset).
+    std::vector<std::array<int, 4>> crossings;
+    for (int i = 0; i < slots.size(); ++i)
+    {
+        if (slots[i].direction != 'a')
+            continue;
+
+        for (int j = crossing_graph.offsets[i]; j < crossing_graph.offsets[i + 1]; ++j)
+        {
+            const auto& crossing = crossing_graph.crossings[j];
+            crossings.push_back({ i, crossing.offset, crossing.slot, crossing.crossing_offset });
+        }
+    }
+
+    // Domains start out as every word of the slot's length and only ever lose the words holding a removed letter.
+    std::vector<std::vector<char>> alive(slots.size());
+    std::vector<int> alive_count(slots.size(), 0);
+    auto applied_masks = masks;
+    for (int round = 0; round < propagation_rounds; ++round)
+    {
+        std::vector<bool> narrowed(slots.size(), false);
+        for (const auto& [across, across_offset, down, down_offset] : crossings)
+        {
+            unsigned int shared = masks[across][across_offset] & masks[down][down_offset];
+            if (shared == 0)
+                return false;
+
+            if (shared != masks[across][across_offset])
+            {
+                masks[across][across_offset] = shared;
+                narrowed[across] = true;
+            }
+            if (shared != masks[down][down_offset])
+            {
+                masks[down][down_offset] = shared;
+                narrowed[down] = true;
+            }
+        }
+
+        if (std::find(narrowed.begin(), narrowed.end(), true) == narrowed.end())
+            break;
+
+        for (int i = 0; i < slots.size(); ++i)
+        {
+            if (!narrowed[i])
+                continue;
+
+            const auto& postings = letter_postings.at(slots[i].length);
+            if (alive[i].empty())
+            {
+                alive[i].assign(constrained_words.at(slots[i].length).size(), true);
+                alive_count[i] = alive[i].size();
+            }
+
+            for (int j = 0; j < slots[i].length; ++j)
+            {
+                unsigned int removed = applied_masks[i][j] & ~masks[i][j];
+                for (int letter = 0; removed; ++letter, removed >>= 1)
+                {
+                    if (!(removed & 1))
+                        continue;
+
+                    for (auto word_index : postings[j][letter])
+                    {
+                        if (alive[i][word_index])
+                        {
+                            alive[i][word_index] = false;
+                            --alive_count[i];
+                        }
+                    }
+                }
+            }
+
+            if (alive_count[i] == 0)
+                return false;
+
+            // Narrow the letters to the ones some remaining word still holds.
+            for (int j = 0; j < slots[i].length; ++j)
+            {
+                for (int letter = 0; letter < 27; ++letter)
+                {
+                    if (!(masks[i][j] & (1u << letter)))
+                        continue;
+
+                    const auto& posting = postings[j][letter];
+                    if (std::none_of(posting.begin(), posting.end(), [&](int word_index) { return alive[i][word_index]; }))
+                        masks[i][j] &= ~(1u << letter);
+                }
+            }
+
+            applied_masks[i] = masks[i];
+        }
+    }
+
+    return true;
+}
+
+//! @brief Map a letter onto its index in a letter mask. Non alphabetic characters share the last index.
+//! @param c The letter.
+//! @return The letter's index.
+int Frame_Generator::letter_index(char c)
+{
+    auto letter = static_cast<unsigned char>(c);
+    if (!isalpha(letter))
+        return 26;
+
+    return tolower(letter) - 'a';
+}
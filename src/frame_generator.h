@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Frame_Generator
+{
+    public:
+        Frame_Generator() = delete;
+        Frame_Generator(int, int, const std::unordered_map<int, std::vector<std::string>>&, unsigned int);
+
+        std::optional<std::vector<std::vector<char>>> next_frame();
+        static std::string to_puzzle_text(const std::vector<std::vector<char>>&);
+
+        std::size_t candidates = 0;
+        std::size_t rejected_layouts = 0;
+        std::size_t rejected_fills = 0;
+        std::size_t consecutive_rejections = 0;
+
+        static constexpr std::size_t rejection_limit = 100000;
+
+    private:
+        bool creates_two_letter_slot(const std::vector<std::vector<char>>&, int, int) const;
+        bool is_connected(const std::vector<std::vector<char>>&) const;
+        bool is_fillable(const std::vector<std::vector<char>>&) const;
+        static int letter_index(char);
+
+        int size;
+        int black_squares;
+        int propagation_rounds = 3;
+        const std::unordered_map<int, std::vector<std::string>>& constrained_words;
+        std::unordered_map<int, std::vector<unsigned int>> letter_masks;
+        std::unordered_map<int, std::vector<std::array<std::vector<int>, 27>>> letter_postings;
+        std::mt19937 random_engine;
+};
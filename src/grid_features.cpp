@@ -0,0 +1,51 @@
+#include "grid_features.h"
+
+#include <algorithm>
+#include <cctype>
+
+//! @brief Extract the cheap structural features of a puzzle and its dictionary.
+//! @param puzzle The crossword puzzle.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+Grid_Features::Grid_Features(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph& crossing_graph, const Word_Index& word_index) :
+    slots(crossing_graph.slots.size())
+{
+    for (const auto& row : puzzle)
+        white_cells += std::count_if(row.begin(), row.end(), [](char cell) { return cell == ' ' || isalpha(cell); });
+
+    // Every checked cell is shared by exactly two slots, so it appears twice among the crossings.
+    checked_cells = crossing_graph.crossings.size() / 2;
+    crossings_per_slot = slots ? static_cast<double>(crossing_graph.crossings.size()) / slots : 0.0;
+
+    min_domain = slots ? word_index.get_word_count(crossing_graph.slots[0].length) : 0;
+    for (const auto& slot : crossing_graph.slots)
+    {
+        ++slot_lengths[slot.length];
+        domain_sizes[slot.length] = word_index.get_word_count(slot.length);
+        min_domain = std::min(min_domain, domain_sizes[slot.length]);
+    }
+}
+
+//! @brief Write the features as space separated key=value pairs.
+//! @param output_stream Output stream.
+//! @param features The features to write.
+//! @return The output stream.
+std::ostream& operator<<(std::ostream& output_stream, const Grid_Features& features)
+{
+    output_stream
+        << "slots=" << features.slots
+        << " white_cells=" << features.white_cells
+        << " checked_cells=" << features.checked_cells
+        << " crossings_per_slot=" << features.crossings_per_slot
+        << " min_domain=" << features.min_domain;
+
+    output_stream << " slot_lengths=";
+    for (auto it = features.slot_lengths.begin(); it != features.slot_lengths.end(); ++it)
+        output_stream << (it == features.slot_lengths.begin() ? "" : ",") << it->first << ':' << it->second;
+
+    output_stream << " domain_sizes=";
+    for (auto it = features.domain_sizes.begin(); it != features.domain_sizes.end(); ++it)
+        output_stream << (it == features.domain_sizes.begin() ? "" : ",") << it->first << ':' << it->second;
+
+    return output_stream;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "crossing_graph.h"
+#include "word_index.h"
+
+#include <map>
+#include <ostream>
+#include <vector>
+
+struct Grid_Features
+{
+    Grid_Features(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&);
+
+    std::size_t slots = 0;
+    std::size_t white_cells = 0;
+    std::size_t checked_cells = 0;
+    double crossings_per_slot = 0.0;
+    std::map<int, std::size_t> slot_lengths;
+    std::map<int, std::size_t> domain_sizes;
+    std::size_t min_domain = 0;
+};
+
+std::ostream& operator<<(std::ostream&, const Grid_Features&);
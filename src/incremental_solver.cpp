@@ -0,0 +1,199 @@
+#include "incremental_solver.h"
+
+#include "crossword_utils.h"
+#include "crossing_graph.h"
+#include "resumable_search.h"
+#include "search_strategies.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+std::string Incremental_Solver::solution_file = "solution.txt";
+std::string Incremental_Solver::edits_file = "edits.txt";
+
+Grid_Edit::Grid_Edit(int y_, int x_, char value_) :
+    y(y_),
+    x(x_),
+    value(value_)
+{}
+
+//! @brief Parse a previously generated solution (rows of letters and '#').
+//! @param crossword_directory The relative or absolute path to the crossword puzzle directory.
+//! @return The solution converted into a 2 dimensional array, with short rows padded by black squares.
+std::vector<std::vector<char>> Incremental_Solver::parse_solution(const std::string& crossword_directory)
+{
+    std::vector<std::vector<char>> solution;
+    std::ifstream solution_input(crossword_directory + "/" + solution_file);
+    if (!solution_input)
+        throw std::runtime_error("Missing " + solution_file + " in " + crossword_directory);
+
+    std::string row;
+    std::size_t width = 0;
+    while (std::getline(solution_input, row))
+    {
+        if (!row.empty())
+        {
+            solution.emplace_back(row.begin(), row.end());
+            width = std::max(width, row.size());
+        }
+    }
+
+    solution_input.close();
+
+    // Solutions of puzzles with ragged rows are ragged too; pad them with black squares so every row is as wide as the grid.
+    for (auto& solution_row : solution)
+        solution_row.resize(width, '#');
+
+    return solution;
+}
+
+//! @brief Parse the edits made to a previous solution.
+//!        Each line holds a row, a column and the new cell value: a letter, '#' for a black square or '.' to clear the cell.
+//! @param crossword_directory The relative or absolute path to the crossword puzzle directory.
+//! @return The edits in file order.
+std::vector<Grid_Edit> Incremental_Solver::parse_edits(const std::string& crossword_directory)
+{
+    std::vector<Grid_Edit> edits;
+    std::ifstream edits_input(crossword_directory + "/" + edits_file);
+    if (!edits_input)
+        throw std::runtime_error("Missing " + edits_file + " in " + crossword_directory);
+
+    int y, x;
+    char value;
+    while (edits_input >> y >> x >> value)
+    {
+        if (value != '#' && value != '.' && !isalpha(value))
+            throw std::runtime_error(std::string("Invalid edit value: ") + value);
+
+        edits.emplace_back(y, x, value == '.' ? ' ' : value);
+    }
+
+    edits_input.close();
+
+    return edits;
+}
+
+//! @brief Refill a previous solution after a few cells were edited.
+//!        Slots that still spell a dictionary word keep it; only the others are searched, by forward checking with the
+//!        kept letters, and the search is widened by one ring of crossing slots each time it cannot fill them.
+//!        A solution file holds letters only, so the slots and crossings of the edited grid are found in one linear pass.
+//! @param previous_solution The filled puzzle before the edits.
+//! @param edits The cells to change. Edited letters are kept fixed.
+//! @param word_index The dictionary indexed by letter position.
+//! @return The refilled puzzle, or nothing if no refill exists.
+std::optional<std::vector<std::vector<char>>> Incremental_Solver::solve(
+    const std::vector<std::vector<char>>& previous_solution,
+    const std::vector<Grid_Edit>& edits,
+    const Word_Index& word_index)
+{
+    auto solution = previous_solution;
+    std::vector<std::vector<bool>> edited(solution.size());
+    for (int y = 0; y < solution.size(); ++y)
+        edited[y].assign(solution[y].size(), false);
+
+    for (const auto& edit : edits)
+    {
+        if (edit.y < 0 || edit.y >= solution.size() || edit.x < 0 || edit.x >= solution[edit.y].size())
+            throw std::runtime_error("Edit out of bounds: " + std::to_string(edit.y) + " " + std::to_string(edit.x));
+
+        solution[edit.y][edit.x] = edit.value;
+        edited[edit.y][edit.x] = true;
+    }
+
+    Crossing_Graph crossing_graph(solution, Crossword_Utils::number_entries(solution));
+    const auto& slots = crossing_graph.slots;
+
+    // Cleared cells, changed letters and moved black squares all leave slots that no longer spell a word.
+    std::vector<bool> in_neighbourhood(slots.size(), false);
+    for (int i = 0; i < slots.size(); ++i)
+        in_neighbourhood[i] = !word_index.contains(get_word(solution, slots[i]));
+
+    if (std::find(in_neighbourhood.begin(), in_neighbourhood.end(), true) == in_neighbourhood.end())
+        return Crossword_Utils::is_full(solution) ? std::optional(solution) : std::nullopt;
+
+    while (true)
+    {
+        // Clear every neighbourhood cell that is neither an edited letter nor held by a kept slot.
+        auto attempt = solution;
+        for (int i = 0; i < slots.size(); ++i)
+        {
+            if (!in_neighbourhood[i])
+                continue;
+
+            const auto& slot = slots[i];
+            int x = slot.x, y = slot.y;
+            for (int j = 0; j < slot.length; ++j)
+            {
+                int crossing = crossing_graph.get_slot(x, y, slot.direction == 'a' ? 'd' : 'a');
+                bool kept = crossing != -1 && !in_neighbourhood[crossing];
+                if (!kept && !(edited[y][x] && isalpha(solution[y][x])))
+                    attempt[y][x] = ' ';
+
+                if (slot.direction == 'a')
+                    ++x;
+                else
+                    ++y;
+            }
+        }
+
+        // A slot held entirely by kept and edited letters is never searched, so its word is checked here.
+        bool fillable = true;
+        for (int i = 0; i < slots.size() && fillable; ++i)
+        {
+            auto word = get_word(attempt, slots[i]);
+            fillable = !in_neighbourhood[i] || word.find(' ') != std::string::npos || word_index.contains(word);
+        }
+
+        if (fillable)
+        {
+            Resumable_Search search(attempt, crossing_graph, word_index, std::make_unique<Forward_Checking_Strategy>(crossing_graph, word_index, attempt));
+            if (search.resume(std::numeric_limits<std::size_t>::max()) == Resumable_Search::Status::solved)
+                return search.get_solution();
+        }
+
+        // Widen the neighbourhood by every slot crossing it.
+        auto widened = in_neighbourhood;
+        bool grew = false;
+        for (int i = 0; i < slots.size(); ++i)
+        {
+            if (!in_neighbourhood[i])
+                continue;
+
+            for (int j = crossing_graph.offsets[i]; j < crossing_graph.offsets[i + 1]; ++j)
+            {
+                int crossing = crossing_graph.crossings[j].slot;
+                grew = grew || !widened[crossing];
+                widened[crossing] = true;
+            }
+        }
+
+        if (!grew)
+            return std::nullopt;
+
+        in_neighbourhood = widened;
+    }
+}
+
+//! @brief Get the letters of a slot.
+//! @param puzzle The crossword puzzle.
+//! @param slot The slot.
+//! @return The letters, with a space for every empty cell.
+std::string Incremental_Solver::get_word(const std::vector<std::vector<char>>& puzzle, const Crossword_Slot& slot)
+{
+    std::string word;
+    int x = slot.x, y = slot.y;
+    for (int i = 0; i < slot.length; ++i)
+    {
+        word.push_back(puzzle[y][x]);
+        if (slot.direction == 'a')
+            ++x;
+        else
+            ++y;
+    }
+
+    return word;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "crossword_slot.h"
+#include "word_index.h"
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Grid_Edit
+{
+    Grid_Edit(int, int, char);
+
+    int y, x;
+    char value;
+};
+
+struct Incremental_Solver
+{
+    Incremental_Solver() = delete;
+
+    static std::vector<std::vector<char>> parse_solution(const std::string&);
+    static std::vector<Grid_Edit> parse_edits(const std::string&);
+    static std::optional<std::vector<std::vector<char>>> solve(const std::vector<std::vector<char>>&, const std::vector<Grid_Edit>&, const Word_Index&);
+
+    private:
+        static std::string get_word(const std::vector<std::vector<char>>&, const Crossword_Slot&);
+
+        static std::string solution_file;
+        static std::string edits_file;
+};
@@ -0,0 +1,283 @@
+#include "local_search.h"
+
+#include <algorithm>
+
+//! @brief Create a local search over a puzzle, starting from a random word of the right length in every slot.
+//!        Letters given by the puzzle are kept: every slot only takes words fitting them.
+//! @param puzzle_ The puzzle to fill.
+//! @param crossing_graph_ The crossings of every slot.
+//! @param word_index_ The dictionary indexed by letter position.
+//! @param seed The seed of the random choices.
+Local_Search::Local_Search(const std::vector<std::vector<char>>& puzzle_, const Crossing_Graph& crossing_graph_, const Word_Index& word_index_, unsigned seed) :
+    puzzle(puzzle_),
+    crossing_graph(crossing_graph_),
+    word_index(word_index_),
+    random(seed)
+{
+    auto slot_count = crossing_graph.slots.size();
+    domains.resize(slot_count);
+    slot_words.resize(slot_count);
+    std::size_t max_word_count = 0;
+    for (int i = 0; i < slot_count; ++i)
+    {
+        const auto& slot = crossing_graph.slots[i];
+        auto words = word_index.constrained_words.find(slot.length);
+        if (words == word_index.constrained_words.end() || words->second.empty())
+        {
+            fillable = false;
+            return;
+        }
+        slot_words[i] = &words->second;
+        max_word_count = std::max(max_word_count, words->second.size());
+
+        int x = slot.x, y = slot.y;
+        for (int j = 0; j < slot.length; ++j)
+        {
+            if (puzzle[y][x] != ' ')
+            {
+                auto matching_words = word_index.get_words(slot.length, j, puzzle[y][x]);
+                domains[i] = domains[i] ? std::make_shared<const Roaring_Bitmap>(domains[i]->intersect(*matching_words)) : matching_words;
+            }
+
+            if (slot.direction == 'a')
+                ++x;
+            else
+                ++y;
+        }
+
+        if (domains[i] && domains[i]->cardinality() == 0)
+        {
+            fillable = false;
+            return;
+        }
+    }
+
+    words.resize(slot_count);
+    for (int i = 0; i < slot_count; ++i)
+        words[i] = choose_random_word(i);
+
+    conflicts.assign(slot_count, 0);
+    conflicted_positions.assign(slot_count, -1);
+    tabu_until.assign(slot_count, 0);
+    matches.assign(max_word_count, 0);
+    for (int i = 0; i < slot_count; ++i)
+    {
+        for (int j = crossing_graph.offsets[i]; j < crossing_graph.offsets[i + 1]; ++j)
+        {
+            const auto& crossing = crossing_graph.crossings[j];
+            if (get_letter(i, crossing.offset) != get_letter(crossing.slot, crossing.crossing_offset))
+                ++conflicts[i];
+        }
+
+        total_conflicts += conflicts[i];
+        update_conflicted(i);
+    }
+
+    // Every crossing was counted from both of its slots.
+    total_conflicts /= 2;
+}
+
+//! @brief Repair the assignment until no crossing letters disagree.
+//!        Every step replaces the word of the most conflicted slot with the word agreeing with the most crossing letters.
+//!        A replaced slot is tabu for a number of steps, and some steps put a random word in a random conflicted slot
+//!        instead, so that the search does not cycle around a local minimum.
+//! @param stop Flag that ends the search early, set once another search has found a fill.
+//! @param deadline The time after which the search gives up.
+//! @return True if the puzzle was filled, false if the search was stopped, ran out of time, or a slot has no fitting word.
+bool Local_Search::run(const std::atomic<bool>& stop, std::chrono::steady_clock::time_point deadline)
+{
+    if (!fillable)
+        return false;
+
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    while (total_conflicts > 0)
+    {
+        if (stop.load(std::memory_order_relaxed) || (steps % 1024 == 0 && std::chrono::steady_clock::now() > deadline))
+            return false;
+
+        ++steps;
+        int slot, word;
+        if (chance(random) < walk_probability)
+        {
+            slot = conflicted[std::uniform_int_distribution<std::size_t>(0, conflicted.size() - 1)(random)];
+            word = choose_random_word(slot);
+        }
+        else
+        {
+            slot = choose_slot();
+            word = choose_word(slot);
+        }
+
+        assign(slot, word);
+        tabu_until[slot] = steps + tabu_tenure;
+    }
+
+    return true;
+}
+
+//! @brief Get the puzzle filled with the current assignment.
+//! @return The puzzle; a valid fill once run has succeeded.
+std::vector<std::vector<char>> Local_Search::get_solution() const
+{
+    auto solution = puzzle;
+    for (int i = 0; i < words.size(); ++i)
+    {
+        const auto& slot = crossing_graph.slots[i];
+        int x = slot.x, y = slot.y;
+        for (auto c : (*slot_words[i])[words[i]])
+        {
+            solution[y][x] = c;
+            if (slot.direction == 'a')
+                ++x;
+            else
+                ++y;
+        }
+    }
+
+    return solution;
+}
+
+//! @brief Choose the conflicted slot with the most conflicts that is not tabu, breaking ties at random.
+//! @return The slot.
+int Local_Search::choose_slot()
+{
+    int best_slot = -1, best_conflicts = 0;
+    std::size_t ties = 0;
+    for (auto slot : conflicted)
+    {
+        if (tabu_until[slot] > steps)
+            continue;
+
+        if (conflicts[slot] > best_conflicts)
+        {
+            best_slot = slot;
+            best_conflicts = conflicts[slot];
+            ties = 1;
+        }
+        else if (conflicts[slot] == best_conflicts && random() % ++ties == 0)
+        {
+            best_slot = slot;
+        }
+    }
+
+    if (best_slot == -1)
+        best_slot = conflicted[std::uniform_int_distribution<std::size_t>(0, conflicted.size() - 1)(random)];
+
+    return best_slot;
+}
+
+//! @brief Choose the word for a slot that agrees with the most crossing letters, other than its current word,
+//!        breaking ties at random. Matches are counted by walking the postings of every crossing letter,
+//!        so only words sharing at least one crossing letter are looked at.
+//! @param slot_index The slot.
+//! @return The index of the word among the dictionary words of the slot's length.
+int Local_Search::choose_word(int slot_index)
+{
+    int length = crossing_graph.slots[slot_index].length;
+    for (int i = crossing_graph.offsets[slot_index]; i < crossing_graph.offsets[slot_index + 1]; ++i)
+    {
+        const auto& crossing = crossing_graph.crossings[i];
+        word_index.get_words(length, crossing.offset, get_letter(crossing.slot, crossing.crossing_offset))->for_each([&](std::uint32_t word)
+        {
+            if (matches[word]++ == 0)
+                matched_words.push_back(word);
+        });
+    }
+
+    int best_word = -1, best_matches = 0;
+    std::size_t ties = 0;
+    const auto& domain = domains[slot_index];
+    for (auto word : matched_words)
+    {
+        if (word == words[slot_index] || (domain && !domain->contains(word)))
+            continue;
+
+        if (matches[word] > best_matches)
+        {
+            best_word = word;
+            best_matches = matches[word];
+            ties = 1;
+        }
+        else if (matches[word] == best_matches && random() % ++ties == 0)
+        {
+            best_word = word;
+        }
+    }
+
+    for (auto word : matched_words)
+        matches[word] = 0;
+    matched_words.clear();
+
+    return best_word == -1 ? choose_random_word(slot_index) : best_word;
+}
+
+//! @brief Choose a random word fitting the letters the puzzle gives a slot.
+//! @param slot_index The slot.
+//! @return The index of the word among the dictionary words of the slot's length.
+int Local_Search::choose_random_word(int slot_index)
+{
+    auto start = std::uniform_int_distribution<std::uint32_t>(0, slot_words[slot_index]->size() - 1)(random);
+    const auto& domain = domains[slot_index];
+    if (!domain)
+        return start;
+
+    auto word = domain->next(start);
+    return word ? *word : *domain->next(0);
+}
+
+//! @brief Put a word in a slot, updating the conflicts of the slot and the slots crossing it.
+//! @param slot_index The slot.
+//! @param word The index of the word among the dictionary words of the slot's length.
+void Local_Search::assign(int slot_index, int word)
+{
+    const auto& new_word = (*slot_words[slot_index])[word];
+    for (int i = crossing_graph.offsets[slot_index]; i < crossing_graph.offsets[slot_index + 1]; ++i)
+    {
+        const auto& crossing = crossing_graph.crossings[i];
+        char crossing_letter = get_letter(crossing.slot, crossing.crossing_offset);
+        bool was_conflict = get_letter(slot_index, crossing.offset) != crossing_letter;
+        bool is_conflict = new_word[crossing.offset] != crossing_letter;
+        if (was_conflict == is_conflict)
+            continue;
+
+        int change = is_conflict ? 1 : -1;
+        conflicts[slot_index] += change;
+        conflicts[crossing.slot] += change;
+        if (is_conflict)
+            ++total_conflicts;
+        else
+            --total_conflicts;
+        update_conflicted(crossing.slot);
+    }
+
+    words[slot_index] = word;
+    update_conflicted(slot_index);
+}
+
+//! @brief Add a slot to or remove it from the conflicted slots, following its conflict count.
+//! @param slot_index The slot.
+void Local_Search::update_conflicted(int slot_index)
+{
+    int& position = conflicted_positions[slot_index];
+    if (conflicts[slot_index] > 0 && position == -1)
+    {
+        position = conflicted.size();
+        conflicted.push_back(slot_index);
+    }
+    else if (conflicts[slot_index] == 0 && position != -1)
+    {
+        conflicted_positions[conflicted.back()] = position;
+        conflicted[position] = conflicted.back();
+        conflicted.pop_back();
+        position = -1;
+    }
+}
+
+//! @brief Get a letter of the word currently in a slot.
+//! @param slot_index The slot.
+//! @param offset The position of the letter in the slot.
+//! @return The letter.
+char Local_Search::get_letter(int slot_index, int offset) const
+{
+    return (*slot_words[slot_index])[words[slot_index]][offset];
+}
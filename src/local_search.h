@@ -0,0 +1,57 @@
+#pragma once
+
+#include "crossing_graph.h"
+#include "roaring_bitmap.h"
+#include "word_index.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+class Local_Search
+{
+    public:
+        Local_Search() = delete;
+        Local_Search(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&, unsigned);
+
+        bool run(const std::atomic<bool>&, std::chrono::steady_clock::time_point);
+        std::vector<std::vector<char>> get_solution() const;
+
+        std::size_t steps = 0;
+        std::size_t tabu_tenure = 10;
+        double walk_probability = 0.1;
+
+    private:
+        int choose_slot();
+        int choose_word(int);
+        int choose_random_word(int);
+        void assign(int, int);
+        void update_conflicted(int);
+        char get_letter(int, int) const;
+
+        std::vector<std::vector<char>> puzzle;
+        const Crossing_Graph& crossing_graph;
+        const Word_Index& word_index;
+        std::mt19937 random;
+        bool fillable = true;
+
+        // The words fitting the letters given by the puzzle, or nullptr if every word of the slot's length fits.
+        std::vector<std::shared_ptr<const Roaring_Bitmap>> domains;
+        std::vector<const std::vector<std::string>*> slot_words;
+        std::vector<int> words;
+
+        // The number of crossings of every slot whose letters disagree, and the slots with at least one.
+        std::vector<int> conflicts;
+        std::size_t total_conflicts = 0;
+        std::vector<int> conflicted;
+        std::vector<int> conflicted_positions;
+        std::vector<std::size_t> tabu_until;
+
+        // Crossing letters matched by every word, reset after every choice.
+        std::vector<std::uint8_t> matches;
+        std::vector<std::uint32_t> matched_words;
+};
@@ -2,40 +2,48 @@
 
 #include "crossword_utils.h"
 
-#include <climits>
-#include <iostream>
-
-//! @brief Perform minimum remaining values heuristic and get the next entry to use.
+//! @brief Perform minimum remaining values heuristic and get the next slot to use.
 //! @param puzzle The crossword puzzle.
-//! @param entries All entries.
-//! @param constrained_words Mapping of word length to corresponding to dictionary words.
-//! @return The next entry and its direction to use.
-std::pair<int, char> MRV_Heuristic::perform(const std::vector<std::vector<char>>& puzzle, const std::vector<Crossword_Entry>& entries, std::unordered_map<int, std::vector<std::string>>& constrained_words)
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+//! @return The index of the unfilled slot whose length has the fewest dictionary words, or -1 if there is none.
+int MRV_Heuristic::perform(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph& crossing_graph, const Word_Index& word_index)
 {
-    int entry_index_mrv = -1;
-    int entry_candidate_words_mrv = INT_MAX;
-    char entry_direction_mrv;
-    for (int i = 0; i < entries.size(); ++i)
+    int slot_index_mrv = -1;
+    std::size_t slot_candidate_words_mrv = 0;
+    for (int i = 0; i < crossing_graph.slots.size(); ++i)
     {
-        auto directions = Crossword_Utils::get_entry_directions(puzzle, entries[i].x, entries[i].y);
-        for (auto direction : directions)
-        {
-            if (Crossword_Utils::is_full(puzzle, entries[i].x, entries[i].y, direction))
-                continue;
+        const auto& slot = crossing_graph.slots[i];
+        if (Crossword_Utils::is_full(puzzle, slot.x, slot.y, slot.direction))
+            continue;
 
-            auto entry_length = Crossword_Utils::get_entry_length(puzzle, entries[i].x, entries[i].y, direction);
-            auto entry_candidate_words = constrained_words[entry_length].size();
-            if (entry_candidate_words < entry_candidate_words_mrv)
-            {
-                entry_candidate_words_mrv = entry_candidate_words;
-                entry_index_mrv = i;
-                entry_direction_mrv = direction;
-            }
+        auto slot_candidate_words = word_index.get_word_count(slot.length);
+        if (slot_index_mrv == -1 || slot_candidate_words < slot_candidate_words_mrv)
+        {
+            slot_candidate_words_mrv = slot_candidate_words;
+            slot_index_mrv = i;
         }
     }
 
-    if (entry_index_mrv == -1)
-        throw std::runtime_error("bruh what");
+    return slot_index_mrv;
+}
+
+//! @brief Perform minimum remaining values heuristic over the forward checked words and get the next slot to use.
+//! @param puzzle The crossword puzzle.
+//! @param checked_words The eligible words of every slot.
+//! @return The index of the unassigned, unfilled slot with the fewest eligible words, or -1 if there is none.
+int MRV_Heuristic::perform(const std::vector<std::vector<char>>& puzzle, const Forward_Checking_Data& checked_words)
+{
+    int slot_index_mrv = -1;
+    for (int i = 0; i < checked_words.crossing_graph.slots.size(); ++i)
+    {
+        const auto& slot = checked_words.crossing_graph.slots[i];
+        if (checked_words.assigned[i] || Crossword_Utils::is_full(puzzle, slot.x, slot.y, slot.direction))
+            continue;
+
+        if (slot_index_mrv == -1 || checked_words.get_eligible_count(i) < checked_words.get_eligible_count(slot_index_mrv))
+            slot_index_mrv = i;
+    }
 
-    return {entry_index_mrv, entry_direction_mrv};
+    return slot_index_mrv;
 }
@@ -1,13 +1,13 @@
 #pragma once
 
-#include "crossword_entry.h"
+#include "crossing_graph.h"
+#include "forward_checking_data.h"
+#include "word_index.h"
 
-#include <unordered_map>
 #include <vector>
-#include <string>
-#include <utility>
 
 struct MRV_Heuristic
 {
-    static std::pair<int, char> perform(const std::vector<std::vector<char>>& puzzle, const std::vector<Crossword_Entry>&, std::unordered_map<int, std::vector<std::string>>&);
+    static int perform(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph&, const Word_Index&);
+    static int perform(const std::vector<std::vector<char>>& puzzle, const Forward_Checking_Data&);
 };
@@ -0,0 +1,297 @@
+#include "resumable_search.h"
+
+#include "crossword_utils.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+//! @brief Create a suspended search over a puzzle.
+//!        The search keeps its position as a stack of fixed-size frames instead of a call stack, and takes back
+//!        placed letters and the strategy's deductions by unwinding trails, so no frame holds a copy of the grid.
+//!        It can be suspended after any node and resumed later, from any thread.
+//! @param puzzle The puzzle to fill.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+//! @param strategy The slot ordering, word ordering and propagation to search with.
+Resumable_Search::Resumable_Search(const std::vector<std::vector<char>>& puzzle, const Crossing_Graph& crossing_graph_, const Word_Index& word_index_, std::unique_ptr<Search_Strategy> strategy_) :
+    solution(puzzle),
+    crossing_graph(crossing_graph_),
+    word_index(word_index_),
+    strategy(std::move(strategy_))
+{
+    // Look up the word list of every slot once, rather than once per candidate.
+    slot_words.reserve(crossing_graph.slots.size());
+    for (const auto& slot : crossing_graph.slots)
+    {
+        auto words = word_index.constrained_words.find(slot.length);
+        slot_words.push_back(words == word_index.constrained_words.end() ? nullptr : &words->second);
+    }
+}
+
+//! @brief Run the search for a number of nodes, or until it is solved, exhausted, or out of its overall budget.
+//!        The overall budget is checked whenever a node is entered.
+//! @param node_budget The number of nodes to enter before suspending.
+//! @return The status of the search.
+Resumable_Search::Status Resumable_Search::resume(std::size_t node_budget)
+{
+    for (std::size_t start = statistics.nodes, checked = statistics.nodes; status == Status::running && statistics.nodes - start < node_budget;)
+    {
+        step();
+        if (statistics.nodes != checked)
+        {
+            checked = statistics.nodes;
+            if (statistics.out_of_budget())
+                break;
+        }
+    }
+
+    return status;
+}
+
+//! @brief Get the status of the search.
+//! @return The status.
+Resumable_Search::Status Resumable_Search::get_status() const
+{
+    return status;
+}
+
+//! @brief Get the puzzle as filled so far; complete once the search is solved.
+//! @return The puzzle.
+const std::vector<std::vector<char>>& Resumable_Search::get_solution() const
+{
+    return solution;
+}
+
+//! @brief Get the search position: the slot and word chosen at every depth.
+//!        Every decision but the last has its word placed; the last one may be between words.
+//! @return The decisions from the outermost frame inward.
+std::vector<Resumable_Search::Decision> Resumable_Search::get_decisions() const
+{
+    std::vector<Decision> decisions;
+    decisions.reserve(frames.size());
+    for (const auto& frame : frames)
+        decisions.push_back({ frame.slot, frame.candidate, frame.placed });
+
+    return decisions;
+}
+
+//! @brief Bring a search that has not run yet to a position taken from another search over the same puzzle and dictionary.
+//!        The eligible words are rebuilt by placing the recorded words again, so only the decisions need to be stored.
+//! @param decisions The decisions to replay, as returned by get_decisions.
+//! @param node_count The number of nodes the other search had visited.
+//! @return True if every decision could be replayed, false otherwise, in which case the search must be discarded.
+bool Resumable_Search::replay(const std::vector<Decision>& decisions, std::size_t node_count)
+{
+    if (started)
+        return false;
+
+    started = true;
+    descend();
+    for (std::size_t depth = 0; depth < decisions.size(); ++depth)
+    {
+        const auto& decision = decisions[depth];
+        if (status != Status::running || frames.size() != depth + 1 || frames[depth].slot != decision.slot)
+            return false;
+
+        if (!decision.placed)
+        {
+            frames[depth].candidate = decision.candidate;
+            if (depth + 1 != decisions.size())
+                return false;
+            break;
+        }
+
+        frames[depth].candidate = decision.candidate - 1;
+        step();
+        if (!frames[depth].placed || frames[depth].candidate != decision.candidate)
+            return false;
+    }
+
+    statistics.nodes = node_count;
+    return true;
+}
+
+//! @brief Estimate the size of the search tree from one random path down it, as proposed by Knuth.
+//!        Every node on the path has all of its children counted before one of them is followed at random;
+//!        the sum of the running products of these branching factors is an unbiased estimate of the number of nodes
+//!        the search would enter if it had to exhaust the tree. The search is left as it was.
+//! @param random The random number generator choosing the path.
+//! @return The estimated number of nodes.
+double Resumable_Search::sample_tree_size(std::mt19937& random)
+{
+    if (started)
+        throw std::runtime_error("Only a search that has not run yet can be sampled.");
+
+    double tree_size = 1.0, level_size = 1.0;
+    std::vector<int> children;
+    while (!Crossword_Utils::is_full(solution))
+    {
+        int slot_index = strategy->select_slot(solution);
+        if (slot_index == -1)
+            break;
+
+        frames.push_back({ slot_index });
+        auto& frame = frames.back();
+
+        children.clear();
+        for (frame.candidate = strategy->next_candidate(slot_index, 0); frame.candidate != -1; frame.candidate = strategy->next_candidate(slot_index, frame.candidate + 1))
+        {
+            if (place(frame))
+                children.push_back(frame.candidate);
+            if (frame.placed)
+                undo(frame);
+        }
+
+        if (children.empty())
+            break;
+
+        level_size *= children.size();
+        tree_size += level_size;
+
+        frame.candidate = children[std::uniform_int_distribution<std::size_t>(0, children.size() - 1)(random)];
+        place(frame);
+    }
+
+    while (!frames.empty())
+    {
+        if (frames.back().placed)
+            undo(frames.back());
+
+        strategy->release_slot(frames.back().slot);
+        frames.pop_back();
+    }
+
+    return tree_size;
+}
+
+//! @brief Advance the top frame to its next eligible word, or pop it once it has none left.
+void Resumable_Search::step()
+{
+    if (frames.empty())
+    {
+        if (started)
+        {
+            status = Status::exhausted;
+            return;
+        }
+
+        started = true;
+        descend();
+        return;
+    }
+
+    auto& frame = frames.back();
+    if (frame.placed)
+        undo(frame);
+
+    frame.candidate = strategy->next_candidate(frame.slot, frame.candidate + 1);
+    if (frame.candidate == -1)
+    {
+        strategy->release_slot(frame.slot);
+        frames.pop_back();
+        ++statistics.failures;
+        return;
+    }
+
+    if (place(frame))
+        descend();
+}
+
+//! @brief Place the current word of a frame and let the strategy propagate it.
+//!        A crossing slot the word fills up is never chosen by the strategies that skip full slots,
+//!        so the word it spells is checked against the dictionary here.
+//! @param frame The frame whose candidate to place.
+//! @return True if the word fits, completes no non-word across it, and its propagation found no dead end, false otherwise.
+bool Resumable_Search::place(Frame& frame)
+{
+    const auto& slot = crossing_graph.slots[frame.slot];
+    const auto& word = (*slot_words[frame.slot])[frame.candidate];
+    if (!Crossword_Utils::word_fits(solution, slot, word))
+        return false;
+
+    for (int i = crossing_graph.offsets[frame.slot]; i < crossing_graph.offsets[frame.slot + 1]; ++i)
+    {
+        const auto& crossing = crossing_graph.crossings[i];
+        if (solution[crossing.y][crossing.x] == ' ' && completes_non_word(crossing, word[crossing.offset]))
+            return false;
+    }
+
+    frame.placed = true;
+    frame.cell_mark = filled_cells.size();
+    int x = slot.x, y = slot.y;
+    for (auto c : word)
+    {
+        if (solution[y][x] == ' ')
+        {
+            solution[y][x] = c;
+            filled_cells.emplace_back(y, x);
+        }
+
+        if (slot.direction == 'a')
+            ++x;
+        else
+            ++y;
+    }
+
+    frame.strategy_mark = strategy->get_trail_mark();
+    return strategy->propagate(solution, frame.slot);
+}
+
+//! @brief Enter a new node: open a frame on the next slot to fill, or mark the search as solved.
+void Resumable_Search::descend()
+{
+    ++statistics.nodes;
+    statistics.depth = frames.size();
+    statistics.max_depth = std::max(statistics.max_depth, statistics.depth);
+
+    if (Crossword_Utils::is_full(solution))
+    {
+        status = Status::solved;
+        return;
+    }
+
+    int slot_index = strategy->select_slot(solution);
+    if (slot_index != -1)
+        frames.push_back({ slot_index });
+}
+
+//! @brief Take back the word placed by a frame.
+//! @param frame The frame to undo.
+void Resumable_Search::undo(Frame& frame)
+{
+    strategy->restore(frame.strategy_mark);
+    while (filled_cells.size() > frame.cell_mark)
+    {
+        auto [y, x] = filled_cells.back();
+        filled_cells.pop_back();
+
+        solution[y][x] = ' ';
+    }
+
+    frame.placed = false;
+    statistics.depth = frames.size() - 1;
+}
+
+//! @brief Check whether a letter in an empty crossing cell fills up the crossing slot with a word outside the dictionary.
+//! @param crossing The crossing whose cell gets the letter.
+//! @param letter The letter.
+//! @return True if the crossing slot is full with the letter and spells a non-word, false otherwise.
+bool Resumable_Search::completes_non_word(const Crossing& crossing, char letter) const
+{
+    const auto& slot = crossing_graph.slots[crossing.slot];
+    std::string crossing_word(slot.length, ' ');
+    int x = slot.x, y = slot.y;
+    for (int i = 0; i < slot.length; ++i)
+    {
+        crossing_word[i] = i == crossing.crossing_offset ? letter : solution[y][x];
+        if (crossing_word[i] == ' ')
+            return false;
+
+        if (slot.direction == 'a')
+            ++x;
+        else
+            ++y;
+    }
+
+    return !word_index.contains(crossing_word);
+}
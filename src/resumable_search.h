@@ -0,0 +1,64 @@
+#pragma once
+
+#include "crossing_graph.h"
+#include "search_statistics.h"
+#include "search_strategy.h"
+#include "word_index.h"
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Resumable_Search
+{
+    public:
+        enum class Status { running, solved, exhausted };
+
+        struct Decision
+        {
+            int slot;
+            int candidate;
+            bool placed;
+        };
+
+        Resumable_Search() = delete;
+        Resumable_Search(const std::vector<std::vector<char>>&, const Crossing_Graph&, const Word_Index&, std::unique_ptr<Search_Strategy>);
+
+        Status resume(std::size_t);
+        Status get_status() const;
+        const std::vector<std::vector<char>>& get_solution() const;
+        std::vector<Decision> get_decisions() const;
+        bool replay(const std::vector<Decision>&, std::size_t);
+        double sample_tree_size(std::mt19937&);
+
+        Search_Statistics statistics;
+
+    private:
+        struct Frame
+        {
+            int slot;
+            int candidate = -1;
+            bool placed = false;
+            std::size_t strategy_mark = 0;
+            std::size_t cell_mark = 0;
+        };
+
+        void step();
+        bool place(Frame&);
+        void descend();
+        void undo(Frame&);
+        bool completes_non_word(const Crossing&, char) const;
+
+        std::vector<std::vector<char>> solution;
+        const Crossing_Graph& crossing_graph;
+        const Word_Index& word_index;
+        std::unique_ptr<Search_Strategy> strategy;
+        std::vector<const std::vector<std::string>*> slot_words;
+        std::vector<Frame> frames;
+        std::vector<std::pair<int, int>> filled_cells;
+        Status status = Status::running;
+        bool started = false;
+};
@@ -0,0 +1,190 @@
+#include "roaring_bitmap.h"
+
+#include <algorithm>
+#include <iterator>
+
+//! @brief Add a value to the bitmap.
+//!        Values are split into a 16 bit container key and a 16 bit low part. Containers hold a sorted array
+//!        of low parts until they grow past array_limit values, and a 65536 bit bitmap afterwards.
+//! @param value The value to add.
+void Roaring_Bitmap::add(std::uint32_t value)
+{
+    std::uint16_t key = value >> 16, low = value & 0xFFFF;
+    auto container = std::lower_bound(containers.begin(), containers.end(), key, [](const Container& lhs, std::uint16_t rhs) { return lhs.key < rhs; });
+    if (container == containers.end() || container->key != key)
+    {
+        container = containers.insert(container, Container());
+        container->key = key;
+    }
+
+    if (!container->bitmap.empty())
+    {
+        auto& word = container->bitmap[low >> 6];
+        if (word & (1ull << (low & 63)))
+            return;
+
+        word |= 1ull << (low & 63);
+    }
+    else
+    {
+        auto position = std::lower_bound(container->array.begin(), container->array.end(), low);
+        if (position != container->array.end() && *position == low)
+            return;
+
+        container->array.insert(position, low);
+    }
+
+    ++container->cardinality;
+    ++total_cardinality;
+    if (container->cardinality > array_limit && container->bitmap.empty())
+        to_bitmap(*container);
+}
+
+//! @brief Check if the bitmap holds a value.
+//! @param value The value to look for.
+//! @return True if the value is in the bitmap, false otherwise.
+bool Roaring_Bitmap::contains(std::uint32_t value) const
+{
+    std::uint16_t key = value >> 16, low = value & 0xFFFF;
+    auto container = std::lower_bound(containers.begin(), containers.end(), key, [](const Container& lhs, std::uint16_t rhs) { return lhs.key < rhs; });
+    if (container == containers.end() || container->key != key)
+        return false;
+
+    if (!container->bitmap.empty())
+        return container->bitmap[low >> 6] & (1ull << (low & 63));
+
+    return std::binary_search(container->array.begin(), container->array.end(), low);
+}
+
+//! @brief Get the smallest value of the bitmap that is not less than a given value.
+//! @param from The value to start from.
+//! @return The value, or nothing if every value of the bitmap is less than from.
+std::optional<std::uint32_t> Roaring_Bitmap::next(std::uint32_t from) const
+{
+    std::uint16_t key = from >> 16;
+    auto container = std::lower_bound(containers.begin(), containers.end(), key, [](const Container& lhs, std::uint16_t rhs) { return lhs.key < rhs; });
+    for (; container != containers.end(); ++container)
+    {
+        std::uint32_t low = container->key == key ? from & 0xFFFF : 0;
+        std::uint32_t high = static_cast<std::uint32_t>(container->key) << 16;
+        if (!container->bitmap.empty())
+        {
+            for (std::uint32_t i = low >> 6; i < container->bitmap.size(); ++i)
+            {
+                std::uint64_t word = container->bitmap[i];
+                if (i == low >> 6)
+                    word &= ~0ull << (low & 63);
+
+                if (word)
+                    return high | (i << 6) | __builtin_ctzll(word);
+            }
+        }
+        else
+        {
+            auto position = std::lower_bound(container->array.begin(), container->array.end(), low);
+            if (position != container->array.end())
+                return high | *position;
+        }
+    }
+
+    return std::nullopt;
+}
+
+//! @brief Get the number of values in the bitmap.
+//! @return The number of values.
+std::size_t Roaring_Bitmap::cardinality() const
+{
+    return total_cardinality;
+}
+
+//! @brief Intersect two bitmaps.
+//! @param other The bitmap to intersect with.
+//! @return The values held by both bitmaps.
+Roaring_Bitmap Roaring_Bitmap::intersect(const Roaring_Bitmap& other) const
+{
+    Roaring_Bitmap result;
+    auto lhs = containers.begin();
+    auto rhs = other.containers.begin();
+    while (lhs != containers.end() && rhs != other.containers.end())
+    {
+        if (lhs->key < rhs->key)
+        {
+            ++lhs;
+            continue;
+        }
+        if (rhs->key < lhs->key)
+        {
+            ++rhs;
+            continue;
+        }
+
+        Container container;
+        container.key = lhs->key;
+        if (!lhs->bitmap.empty() && !rhs->bitmap.empty())
+        {
+            container.bitmap.resize(lhs->bitmap.size());
+            for (std::size_t i = 0; i < container.bitmap.size(); ++i)
+            {
+                container.bitmap[i] = lhs->bitmap[i] & rhs->bitmap[i];
+                container.cardinality += __builtin_popcountll(container.bitmap[i]);
+            }
+
+            if (container.cardinality <= array_limit)
+                to_array(container);
+        }
+        else if (lhs->bitmap.empty() && rhs->bitmap.empty())
+        {
+            std::set_intersection(lhs->array.begin(), lhs->array.end(), rhs->array.begin(), rhs->array.end(), std::back_inserter(container.array));
+            container.cardinality = container.array.size();
+        }
+        else
+        {
+            const auto& array = lhs->bitmap.empty() ? lhs->array : rhs->array;
+            const auto& bitmap = lhs->bitmap.empty() ? rhs->bitmap : lhs->bitmap;
+            for (auto low : array)
+            {
+                if (bitmap[low >> 6] & (1ull << (low & 63)))
+                    container.array.push_back(low);
+            }
+            container.cardinality = container.array.size();
+        }
+
+        if (container.cardinality > 0)
+        {
+            result.total_cardinality += container.cardinality;
+            result.containers.push_back(std::move(container));
+        }
+
+        ++lhs;
+        ++rhs;
+    }
+
+    return result;
+}
+
+//! @brief Convert an array container into a bitmap container.
+//! @param container The container to convert.
+void Roaring_Bitmap::to_bitmap(Container& container)
+{
+    container.bitmap.assign(1024, 0);
+    for (auto low : container.array)
+        container.bitmap[low >> 6] |= 1ull << (low & 63);
+
+    container.array.clear();
+    container.array.shrink_to_fit();
+}
+
+//! @brief Convert a bitmap container into an array container.
+//! @param container The container to convert.
+void Roaring_Bitmap::to_array(Container& container)
+{
+    container.array.reserve(container.cardinality);
+    for (std::uint32_t i = 0; i < container.bitmap.size(); ++i)
+    {
+        for (std::uint64_t word = container.bitmap[i]; word; word &= word - 1)
+            container.array.push_back((i << 6) | __builtin_ctzll(word));
+    }
+
+    container.bitmap.clear();
+    container.bitmap.shrink_to_fit();
+}
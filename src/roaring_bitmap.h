@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class Roaring_Bitmap
+{
+    public:
+        void add(std::uint32_t);
+        bool contains(std::uint32_t) const;
+        std::optional<std::uint32_t> next(std::uint32_t) const;
+        std::size_t cardinality() const;
+        Roaring_Bitmap intersect(const Roaring_Bitmap&) const;
+
+        template <typename Visitor>
+        void for_each(Visitor) const;
+
+    private:
+        struct Container
+        {
+            std::uint16_t key;
+            std::uint32_t cardinality = 0;
+            std::vector<std::uint16_t> array;
+            std::vector<std::uint64_t> bitmap;
+        };
+
+        static void to_bitmap(Container&);
+        static void to_array(Container&);
+
+        static constexpr std::uint32_t array_limit = 4096;
+
+        std::vector<Container> containers;
+        std::size_t total_cardinality = 0;
+};
+
+//! @brief Visit every value of the bitmap in ascending order.
+//! @param visit Called with every value.
+template <typename Visitor>
+void Roaring_Bitmap::for_each(Visitor visit) const
+{
+    for (const auto& container : containers)
+    {
+        std::uint32_t high = static_cast<std::uint32_t>(container.key) << 16;
+        if (!container.bitmap.empty())
+        {
+            for (std::uint32_t i = 0; i < container.bitmap.size(); ++i)
+            {
+                for (std::uint64_t word = container.bitmap[i]; word; word &= word - 1)
+                    visit(high | (i << 6) | __builtin_ctzll(word));
+            }
+        }
+        else
+        {
+            for (auto low : container.array)
+                visit(high | low);
+        }
+    }
+}
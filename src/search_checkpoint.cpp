@@ -0,0 +1,127 @@
+#include "search_checkpoint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+std::string Search_Checkpoint::checkpoint_file = "checkpoint.txt";
+
+//! @brief Create the checkpoint of a puzzle directory.
+//! @param crossword_directory The relative or absolute path to the crossword puzzle directory.
+//! @param constrained_words The dictionary the search runs on.
+//! @param puzzle The puzzle the search fills.
+Search_Checkpoint::Search_Checkpoint(const std::string& crossword_directory, const std::unordered_map<int, std::vector<std::string>>& constrained_words, const std::vector<std::vector<char>>& puzzle) :
+    path(crossword_directory + "/" + checkpoint_file),
+    dictionary_hash(hash_dictionary(constrained_words)),
+    puzzle_hash(hash_puzzle(puzzle))
+{}
+
+//! @brief Bring a search that has not run yet to the saved position, if there is one.
+//!        The file holds the two hashes and the node count on its first line, followed by one "slot word placed" line per depth.
+//!        A corrupt checkpoint, or one made with another dictionary or puzzle, throws a runtime_error; the search may then
+//!        be partly replayed and should be replaced by a fresh one.
+//! @param search The search to resume.
+//! @return True if a checkpoint was loaded, false if there is none.
+bool Search_Checkpoint::load(Resumable_Search& search) const
+{
+    std::ifstream checkpoint_input(path);
+    if (!checkpoint_input)
+        return false;
+
+    std::uint64_t saved_dictionary_hash, saved_puzzle_hash;
+    std::size_t nodes;
+    if (!(checkpoint_input >> std::hex >> saved_dictionary_hash >> saved_puzzle_hash >> std::dec >> nodes))
+        throw std::runtime_error("Checkpoint " + path + " is corrupt.");
+    if (saved_dictionary_hash != dictionary_hash)
+        throw std::runtime_error("Checkpoint " + path + " was made with a different dictionary.");
+    if (saved_puzzle_hash != puzzle_hash)
+        throw std::runtime_error("Checkpoint " + path + " was made with a different puzzle.");
+
+    std::vector<Resumable_Search::Decision> decisions;
+    Resumable_Search::Decision decision;
+    while (checkpoint_input >> decision.slot >> decision.candidate >> decision.placed)
+        decisions.push_back(decision);
+
+    if (!checkpoint_input.eof() || !search.replay(decisions, nodes))
+        throw std::runtime_error("Checkpoint " + path + " is corrupt.");
+
+    return true;
+}
+
+//! @brief Save the position of a search.
+//!        The checkpoint is written next to the old one and renamed over it, so an interrupted save keeps the previous checkpoint intact.
+//! @param search The search to save.
+void Search_Checkpoint::save(const Resumable_Search& search) const
+{
+    std::string temporary_path = path + ".tmp";
+    {
+        std::ofstream checkpoint_output(temporary_path, std::ios::trunc);
+        checkpoint_output << std::hex << dictionary_hash << ' ' << puzzle_hash << std::dec << ' ' << search.statistics.nodes << '\n';
+        for (const auto& decision : search.get_decisions())
+            checkpoint_output << decision.slot << ' ' << decision.candidate << ' ' << decision.placed << '\n';
+
+        if (!checkpoint_output.flush())
+            throw std::runtime_error("Unable to write checkpoint: " + temporary_path);
+    }
+
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+        throw std::runtime_error("Unable to replace checkpoint: " + path);
+}
+
+//! @brief Remove the checkpoint once the search has finished.
+void Search_Checkpoint::discard() const
+{
+    std::remove(path.c_str());
+}
+
+//! @brief Hash a dictionary, word order included, since searches refer to words by their index.
+//! @param constrained_words The dictionary grouped by word length.
+//! @return The 64-bit FNV-1a hash.
+std::uint64_t Search_Checkpoint::hash_dictionary(const std::unordered_map<int, std::vector<std::string>>& constrained_words)
+{
+    std::vector<int> lengths;
+    for (const auto& [length, words] : constrained_words)
+        lengths.push_back(length);
+    std::sort(lengths.begin(), lengths.end());
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (auto length : lengths)
+    {
+        for (const auto& word : constrained_words.at(length))
+        {
+            hash_bytes(hash, word.data(), word.size());
+            hash_bytes(hash, "\n", 1);
+        }
+    }
+
+    return hash;
+}
+
+//! @brief Hash a puzzle, including its dimensions.
+//! @param puzzle The puzzle.
+//! @return The 64-bit FNV-1a hash.
+std::uint64_t Search_Checkpoint::hash_puzzle(const std::vector<std::vector<char>>& puzzle)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const auto& row : puzzle)
+    {
+        hash_bytes(hash, row.data(), row.size());
+        hash_bytes(hash, "\n", 1);
+    }
+
+    return hash;
+}
+
+//! @brief Feed bytes into a 64-bit FNV-1a hash.
+//! @param hash The hash to update.
+//! @param bytes The bytes to add.
+//! @param count The number of bytes.
+void Search_Checkpoint::hash_bytes(std::uint64_t& hash, const char* bytes, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        hash ^= static_cast<unsigned char>(bytes[i]);
+        hash *= 1099511628211ull;
+    }
+}
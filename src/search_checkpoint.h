@@ -0,0 +1,32 @@
+#pragma once
+
+#include "resumable_search.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Search_Checkpoint
+{
+    public:
+        Search_Checkpoint() = delete;
+        Search_Checkpoint(const std::string&, const std::unordered_map<int, std::vector<std::string>>&, const std::vector<std::vector<char>>&);
+
+        bool load(Resumable_Search&) const;
+        void save(const Resumable_Search&) const;
+        void discard() const;
+
+        static std::uint64_t hash_dictionary(const std::unordered_map<int, std::vector<std::string>>&);
+        static std::uint64_t hash_puzzle(const std::vector<std::vector<char>>&);
+
+    private:
+        std::string path;
+        std::uint64_t dictionary_hash;
+        std::uint64_t puzzle_hash;
+
+        static void hash_bytes(std::uint64_t&, const char*, std::size_t);
+
+        static std::string checkpoint_file;
+};
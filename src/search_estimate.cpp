@@ -0,0 +1,73 @@
+#include "search_estimate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+//! @brief Estimate how many nodes, and how much time, a search needs to exhaust its tree.
+//!        A quarter of the time budget runs the search itself to measure its speed; if it finishes within that time,
+//!        its actual node count and runtime are reported instead. The rest of the budget goes to random probes down
+//!        the tree, whose mean is reported with a 95% confidence interval. Since a search stops at its first solution,
+//!        the estimate is an upper bound for puzzles that can be filled.
+//! @param make_search Creates a search that has not run yet, with the slot ordering and propagation to estimate.
+//! @param time_budget The time to spend on the estimate.
+//! @param seed The seed of the random probes.
+Search_Estimate::Search_Estimate(const std::function<std::unique_ptr<Resumable_Search>()>& make_search, std::chrono::milliseconds time_budget, unsigned int seed)
+{
+    auto start_time = std::chrono::steady_clock::now();
+    auto search = make_search();
+    search->statistics.deadline = start_time + time_budget / 4;
+    auto status = search->resume(std::numeric_limits<std::size_t>::max());
+
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    nodes_per_second = search->statistics.nodes / std::max(elapsed_seconds, 1e-9);
+    if (status != Resumable_Search::Status::running)
+    {
+        outcome = status == Resumable_Search::Status::solved ? "solved" : "exhausted";
+        nodes = nodes_low = nodes_high = search->statistics.nodes;
+        seconds = seconds_low = seconds_high = elapsed_seconds;
+        return;
+    }
+
+    // Welford's running mean and variance of the probe estimates.
+    std::mt19937 random(seed);
+    auto sampled_search = make_search();
+    double squared_deviations = 0.0;
+    for (auto deadline = start_time + time_budget; probes < 2 || std::chrono::steady_clock::now() < deadline;)
+    {
+        double tree_size = sampled_search->sample_tree_size(random);
+        double deviation = tree_size - nodes;
+        nodes += deviation / ++probes;
+        squared_deviations += deviation * (tree_size - nodes);
+    }
+
+    double margin = 1.96 * std::sqrt(squared_deviations / (probes - 1) / probes);
+    // The measuring run entered that many nodes without exhausting the tree.
+    nodes_low = std::max<double>(search->statistics.nodes, nodes - margin);
+    nodes_high = nodes + margin;
+
+    seconds = nodes / nodes_per_second;
+    seconds_low = nodes_low / nodes_per_second;
+    seconds_high = nodes_high / nodes_per_second;
+}
+
+//! @brief Write the estimate as space separated key=value pairs.
+//! @param output_stream Output stream.
+//! @param estimate The estimate to write.
+//! @return The output stream.
+std::ostream& operator<<(std::ostream& output_stream, const Search_Estimate& estimate)
+{
+    output_stream
+        << "outcome=" << estimate.outcome
+        << " probes=" << estimate.probes
+        << " nodes=" << estimate.nodes
+        << " nodes_low=" << estimate.nodes_low
+        << " nodes_high=" << estimate.nodes_high
+        << " nodes_per_second=" << estimate.nodes_per_second
+        << " seconds=" << estimate.seconds
+        << " seconds_low=" << estimate.seconds_low
+        << " seconds_high=" << estimate.seconds_high;
+
+    return output_stream;
+}
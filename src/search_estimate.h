@@ -0,0 +1,26 @@
+#pragma once
+
+#include "resumable_search.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+
+struct Search_Estimate
+{
+    Search_Estimate(const std::function<std::unique_ptr<Resumable_Search>()>&, std::chrono::milliseconds, unsigned int);
+
+    std::string outcome = "estimated";
+    std::size_t probes = 0;
+    double nodes = 0.0;
+    double nodes_low = 0.0;
+    double nodes_high = 0.0;
+    double nodes_per_second = 0.0;
+    double seconds = 0.0;
+    double seconds_low = 0.0;
+    double seconds_high = 0.0;
+};
+
+std::ostream& operator<<(std::ostream&, const Search_Estimate&);
@@ -0,0 +1,72 @@
+#include "search_scheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+//! @brief Create a cooperative scheduler of resumable searches.
+//! @param quantum_ The number of nodes a search runs before yielding to the next one.
+//! @param thread_count_ The number of worker threads.
+Search_Scheduler::Search_Scheduler(std::size_t quantum_, std::size_t thread_count_) :
+    quantum(std::max<std::size_t>(quantum_, 1)),
+    thread_count(std::max<std::size_t>(thread_count_, 1))
+{}
+
+//! @brief Add a search to the scheduler.
+//! @param search The search to run.
+//! @param priority Searches of higher priority are resumed first; searches of equal priority take turns.
+//! @return The identifier of the search.
+int Search_Scheduler::add(std::unique_ptr<Resumable_Search> search, int priority)
+{
+    std::lock_guard lock(mutex);
+    int search_id = searches.size();
+    searches.push_back(std::move(search));
+    priorities.push_back(priority);
+    ready.emplace(priority, -turn++, search_id);
+    ++unfinished;
+
+    return search_id;
+}
+
+//! @brief Run every search to completion on the worker threads.
+//! @param on_finished Called, one search at a time, with the identifier and the search whenever a search is solved or exhausted.
+void Search_Scheduler::run(const std::function<void(int, const Resumable_Search&)>& on_finished)
+{
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < thread_count; ++i)
+        workers.emplace_back(&Search_Scheduler::work, this, std::cref(on_finished));
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+//! @brief Repeatedly resume the first ready search for one quantum until every search is finished.
+//! @param on_finished Called with the identifier and the search whenever a search is solved or exhausted.
+void Search_Scheduler::work(const std::function<void(int, const Resumable_Search&)>& on_finished)
+{
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        ready_changed.wait(lock, [&] { return !ready.empty() || unfinished == 0; });
+        if (unfinished == 0)
+            return;
+
+        int search_id = std::get<2>(ready.top());
+        ready.pop();
+
+        lock.unlock();
+        auto status = searches[search_id]->resume(quantum);
+        lock.lock();
+
+        if (status == Resumable_Search::Status::running)
+        {
+            ready.emplace(priorities[search_id], -turn++, search_id);
+        }
+        else
+        {
+            on_finished(search_id, *searches[search_id]);
+            --unfinished;
+        }
+
+        ready_changed.notify_all();
+    }
+}
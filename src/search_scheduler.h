@@ -0,0 +1,37 @@
+#pragma once
+
+#include "resumable_search.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+class Search_Scheduler
+{
+    public:
+        Search_Scheduler() = delete;
+        Search_Scheduler(std::size_t, std::size_t);
+
+        int add(std::unique_ptr<Resumable_Search>, int);
+        void run(const std::function<void(int, const Resumable_Search&)>&);
+
+    private:
+        void work(const std::function<void(int, const Resumable_Search&)>&);
+
+        std::size_t quantum;
+        std::size_t thread_count;
+        std::vector<std::unique_ptr<Resumable_Search>> searches;
+        std::vector<int> priorities;
+
+        // Ready searches as (priority, -turn, search), so higher priorities go first and equal ones take turns.
+        std::priority_queue<std::tuple<int, long long, int>> ready;
+        long long turn = 0;
+        std::size_t unfinished = 0;
+        std::mutex mutex;
+        std::condition_variable ready_changed;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+struct Search_Statistics
+{
+    bool out_of_budget() const
+    {
+        return nodes > node_limit || std::chrono::steady_clock::now() > deadline;
+    }
+
+    std::size_t nodes = 0;
+    std::size_t failures = 0;
+    std::size_t depth = 0;
+    std::size_t max_depth = 0;
+    std::size_t node_limit = std::numeric_limits<std::size_t>::max();
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+};
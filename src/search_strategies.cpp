@@ -0,0 +1,163 @@
+#include "search_strategies.h"
+
+#include "lcv_heuristic.h"
+#include "mrv_heuristic.h"
+
+//! @brief Create the strategy of plain backtracking: slots in graph order, words in dictionary order.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+Backtracking_Strategy::Backtracking_Strategy(const Crossing_Graph& crossing_graph_, const Word_Index& word_index_) :
+    crossing_graph(crossing_graph_),
+    word_index(word_index_),
+    assigned(crossing_graph_.slots.size(), false)
+{
+    for (const auto& slot : crossing_graph.slots)
+        word_counts.push_back(word_index.get_word_count(slot.length));
+}
+
+//! @brief Choose the first slot that has not been chosen yet. The puzzle is not needed, since slots go in graph order.
+//! @return The slot index, or -1 if every slot has been chosen.
+int Backtracking_Strategy::select_slot(const std::vector<std::vector<char>>&)
+{
+    for (int i = 0; i < assigned.size(); ++i)
+    {
+        if (!assigned[i])
+        {
+            assigned[i] = true;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+//! @brief Release a slot once all of its words have been tried.
+//! @param slot_index The slot to release.
+void Backtracking_Strategy::release_slot(int slot_index)
+{
+    assigned[slot_index] = false;
+}
+
+//! @brief Get the next dictionary word of the slot's length; the search skips the ones that do not fit.
+//! @param slot_index The slot being filled.
+//! @param from The first word index to consider.
+//! @return The word index, or -1 once every word has been tried.
+int Backtracking_Strategy::next_candidate(int slot_index, int from) const
+{
+    return from < word_counts[slot_index] ? from : -1;
+}
+
+//! @brief Choose the unfilled slot whose length has the fewest dictionary words.
+//! @param puzzle The crossword puzzle.
+//! @return The slot index, or -1 if every slot is filled.
+int MRV_Strategy::select_slot(const std::vector<std::vector<char>>& puzzle)
+{
+    return MRV_Heuristic::perform(puzzle, crossing_graph, word_index);
+}
+
+//! @brief Choose the unfilled slot with the most filled crossing cells.
+//! @param puzzle The crossword puzzle.
+//! @return The slot index.
+int LCV_Strategy::select_slot(const std::vector<std::vector<char>>& puzzle)
+{
+    return LCV_Heuristic::perform(puzzle, crossing_graph);
+}
+
+//! @brief Create the strategy of forward checking with the MRV heuristic over the eligible words of every slot.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+Forward_Checking_Strategy::Forward_Checking_Strategy(const Crossing_Graph& crossing_graph, const Word_Index& word_index) :
+    checked_words(crossing_graph, word_index)
+{}
+
+//! @brief Create the strategy of forward checking for a puzzle that starts partly filled,
+//!        with the eligible words of every slot narrowed to the letters it already holds.
+//! @param crossing_graph The crossings of every slot.
+//! @param word_index The dictionary indexed by letter position.
+//! @param puzzle The partly filled puzzle.
+Forward_Checking_Strategy::Forward_Checking_Strategy(const Crossing_Graph& crossing_graph, const Word_Index& word_index, const std::vector<std::vector<char>>& puzzle) :
+    checked_words(crossing_graph, word_index)
+{
+    checked_words.restrict_to_letters(puzzle);
+}
+
+//! @brief Choose the unassigned, unfilled slot with the fewest eligible words.
+//! @param puzzle The crossword puzzle.
+//! @return The slot index, or -1 if there is none.
+int Forward_Checking_Strategy::select_slot(const std::vector<std::vector<char>>& puzzle)
+{
+    int slot_index = MRV_Heuristic::perform(puzzle, checked_words);
+    if (slot_index != -1)
+        checked_words.assigned[slot_index] = true;
+
+    return slot_index;
+}
+
+//! @brief Release a slot, so that its eligible words are filtered again.
+//! @param slot_index The slot to release.
+void Forward_Checking_Strategy::release_slot(int slot_index)
+{
+    checked_words.assigned[slot_index] = false;
+}
+
+//! @brief Get the next eligible word of a slot.
+//! @param slot_index The slot being filled.
+//! @param from The first word index to consider.
+//! @return The word index, or -1 if there is none.
+int Forward_Checking_Strategy::next_candidate(int slot_index, int from) const
+{
+    return checked_words.next_eligible_word(slot_index, from);
+}
+
+//! @brief Filter the eligible words of every slot crossing the one just filled.
+//! @param puzzle The crossword puzzle.
+//! @param slot_index The slot just filled.
+//! @return False if a crossing slot has no eligible words left.
+bool Forward_Checking_Strategy::propagate(const std::vector<std::vector<char>>& puzzle, int slot_index)
+{
+    checked_words.eliminate_words(puzzle, slot_index);
+    return !checked_words.wiped_out(slot_index);
+}
+
+//! @brief Mark the filtering done so far.
+//! @return The trail mark.
+std::size_t Forward_Checking_Strategy::get_trail_mark() const
+{
+    return checked_words.get_trail_mark();
+}
+
+//! @brief Undo every filtering done after a mark.
+//! @param trail_mark The mark to return to.
+void Forward_Checking_Strategy::restore(std::size_t trail_mark)
+{
+    checked_words.restore(trail_mark);
+}
+
+//! @brief Create the strategy of the dom/wdeg heuristic over forward checked eligible words.
+//! @param word_index The dictionary indexed by letter position.
+//! @param heuristic_ The crossing weights, kept across restarts.
+WDEG_Strategy::WDEG_Strategy(const Word_Index& word_index, WDEG_Heuristic& heuristic_) :
+    Forward_Checking_Strategy(heuristic_.crossing_graph, word_index),
+    heuristic(heuristic_)
+{}
+
+//! @brief Choose the unassigned, unfilled slot with the fewest eligible words per weighted crossing.
+//! @param puzzle The crossword puzzle.
+//! @return The slot index, or -1 if there is none.
+int WDEG_Strategy::select_slot(const std::vector<std::vector<char>>& puzzle)
+{
+    int slot_index = heuristic.perform(puzzle, checked_words);
+    if (slot_index != -1)
+        checked_words.assigned[slot_index] = true;
+
+    return slot_index;
+}
+
+//! @brief Filter the eligible words of every slot crossing the one just filled, weighting the crossing that wipes one out.
+//! @param puzzle The crossword puzzle.
+//! @param slot_index The slot just filled.
+//! @return False if a crossing slot has no eligible word left.
+bool WDEG_Strategy::propagate(const std::vector<std::vector<char>>& puzzle, int slot_index)
+{
+    return heuristic.propagate(puzzle, slot_index, checked_words);
+}
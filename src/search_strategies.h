@@ -0,0 +1,72 @@
+#pragma once
+
+#include "crossing_graph.h"
+#include "forward_checking_data.h"
+#include "search_strategy.h"
+#include "wdeg_heuristic.h"
+#include "word_index.h"
+
+#include <vector>
+
+class Backtracking_Strategy : public Search_Strategy
+{
+    public:
+        Backtracking_Strategy(const Crossing_Graph&, const Word_Index&);
+
+        int select_slot(const std::vector<std::vector<char>>&) override;
+        void release_slot(int) override;
+        int next_candidate(int, int) const override;
+
+    protected:
+        const Crossing_Graph& crossing_graph;
+        const Word_Index& word_index;
+
+    private:
+        std::vector<bool> assigned;
+        std::vector<std::size_t> word_counts;
+};
+
+class MRV_Strategy : public Backtracking_Strategy
+{
+    public:
+        using Backtracking_Strategy::Backtracking_Strategy;
+
+        int select_slot(const std::vector<std::vector<char>>&) override;
+};
+
+class LCV_Strategy : public Backtracking_Strategy
+{
+    public:
+        using Backtracking_Strategy::Backtracking_Strategy;
+
+        int select_slot(const std::vector<std::vector<char>>&) override;
+};
+
+class Forward_Checking_Strategy : public Search_Strategy
+{
+    public:
+        Forward_Checking_Strategy(const Crossing_Graph&, const Word_Index&);
+        Forward_Checking_Strategy(const Crossing_Graph&, const Word_Index&, const std::vector<std::vector<char>>&);
+
+        int select_slot(const std::vector<std::vector<char>>&) override;
+        void release_slot(int) override;
+        int next_candidate(int, int) const override;
+        bool propagate(const std::vector<std::vector<char>>&, int) override;
+        std::size_t get_trail_mark() const override;
+        void restore(std::size_t) override;
+
+    protected:
+        Forward_Checking_Data checked_words;
+};
+
+class WDEG_Strategy : public Forward_Checking_Strategy
+{
+    public:
+        WDEG_Strategy(const Word_Index&, WDEG_Heuristic&);
+
+        int select_slot(const std::vector<std::vector<char>>&) override;
+        bool propagate(const std::vector<std::vector<char>>&, int) override;
+
+    private:
+        WDEG_Heuristic& heuristic;
+};
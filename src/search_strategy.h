@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+//! @brief The pluggable part of a search: which slot to fill next, in which order to try its words,
+//!        and what to deduce after a word is placed. The search itself lives in Resumable_Search.
+class Search_Strategy
+{
+    public:
+        virtual ~Search_Strategy() = default;
+
+        //! @brief Choose the next slot to fill; it stays chosen until released.
+        //! @return The slot index, or -1 if no slot can be chosen below this node.
+        virtual int select_slot(const std::vector<std::vector<char>>&) = 0;
+
+        //! @brief Release a slot once all of its words have been tried.
+        virtual void release_slot(int) {}
+
+        //! @brief Get the next word to try in a slot, as an index into the words of its length.
+        //! @return The first candidate at or after the given index, or -1 if there is none.
+        virtual int next_candidate(int, int) const = 0;
+
+        //! @brief Deduce what follows from the word just placed in a slot.
+        //! @return False if the placement leads to a dead end.
+        virtual bool propagate(const std::vector<std::vector<char>>&, int) { return true; }
+
+        //! @brief Mark the deductions made so far, to be undone with restore.
+        virtual std::size_t get_trail_mark() const { return 0; }
+
+        //! @brief Undo every deduction made after a mark.
+        virtual void restore(std::size_t) {}
+};
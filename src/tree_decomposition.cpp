@@ -0,0 +1,194 @@
+#include "tree_decomposition.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <tuple>
+
+//! @brief Decompose the crossing graph into a tree of clusters of slots (bags).
+//!        Slots are eliminated in min-fill order; every slot forms a bag with its neighbours at elimination,
+//!        hanging below the bag of the first of those neighbours to be eliminated. A bag that contains its parent
+//!        replaces it. Every crossing lies within a bag, and the bags holding a slot form a subtree, so a subtree
+//!        only depends on the rest of the puzzle through the cells its separator (the slots shared with the parent) fixes.
+//! @param crossing_graph The crossings of every slot.
+Tree_Decomposition::Tree_Decomposition(const Crossing_Graph& crossing_graph)
+{
+    int slot_count = crossing_graph.slots.size();
+    std::vector<std::set<int>> neighbours(slot_count);
+    for (int i = 0; i < slot_count; ++i)
+    {
+        for (int j = crossing_graph.offsets[i]; j < crossing_graph.offsets[i + 1]; ++j)
+        {
+            if (crossing_graph.crossings[j].slot != i)
+                neighbours[i].insert(crossing_graph.crossings[j].slot);
+        }
+    }
+
+    auto get_fill = [&](int slot)
+    {
+        int fill = 0;
+        for (auto a = neighbours[slot].begin(); a != neighbours[slot].end(); ++a)
+        {
+            for (auto b = std::next(a); b != neighbours[slot].end(); ++b)
+                fill += !neighbours[*a].count(*b);
+        }
+
+        return fill;
+    };
+
+    // Min-fill elimination, breaking ties by degree and then by slot index.
+    std::vector<int> fills(slot_count);
+    std::set<std::tuple<int, int, int>> queue;
+    for (int i = 0; i < slot_count; ++i)
+    {
+        fills[i] = get_fill(i);
+        queue.emplace(fills[i], neighbours[i].size(), i);
+    }
+
+    std::vector<int> elimination_order, elimination_positions(slot_count);
+    std::vector<std::vector<int>> slot_bags(slot_count);
+    while (!queue.empty())
+    {
+        int slot = std::get<2>(*queue.begin());
+        queue.erase(queue.begin());
+        elimination_positions[slot] = elimination_order.size();
+        elimination_order.push_back(slot);
+
+        std::set<int> affected;
+        for (auto neighbour : neighbours[slot])
+        {
+            queue.erase({ fills[neighbour], neighbours[neighbour].size(), neighbour });
+            affected.insert(neighbours[neighbour].begin(), neighbours[neighbour].end());
+        }
+
+        for (auto neighbour : neighbours[slot])
+        {
+            neighbours[neighbour].erase(slot);
+            for (auto other : neighbours[slot])
+            {
+                if (other != neighbour)
+                    neighbours[neighbour].insert(other);
+            }
+        }
+
+        for (auto other : affected)
+        {
+            if (other == slot || neighbours[slot].count(other))
+                continue;
+            if (queue.erase({ fills[other], neighbours[other].size(), other }))
+            {
+                fills[other] = get_fill(other);
+                queue.emplace(fills[other], neighbours[other].size(), other);
+            }
+        }
+
+        for (auto neighbour : neighbours[slot])
+        {
+            fills[neighbour] = get_fill(neighbour);
+            queue.emplace(fills[neighbour], neighbours[neighbour].size(), neighbour);
+        }
+
+        slot_bags[slot].assign(neighbours[slot].begin(), neighbours[slot].end());
+        slot_bags[slot].push_back(slot);
+        std::sort(slot_bags[slot].begin(), slot_bags[slot].end());
+        neighbours[slot].clear();
+    }
+
+    // Build the tree from the root down, letting a bag that contains its parent take the parent's place.
+    std::vector<int> bag_owners(slot_count, -1), clusters(slot_count, -1);
+    for (int k = slot_count - 1; k >= 0; --k)
+    {
+        int slot = elimination_order[k];
+        int parent_slot = -1;
+        for (auto other : slot_bags[slot])
+        {
+            if (other != slot && (parent_slot == -1 || elimination_positions[other] < elimination_positions[parent_slot]))
+                parent_slot = other;
+        }
+
+        int parent = parent_slot == -1 ? -1 : clusters[parent_slot];
+        if (parent != -1 && std::includes(slot_bags[slot].begin(), slot_bags[slot].end(), bags[parent].begin(), bags[parent].end()))
+        {
+            bags[parent] = slot_bags[slot];
+            clusters[slot] = parent;
+            continue;
+        }
+
+        clusters[slot] = bags.size();
+        bags.push_back(slot_bags[slot]);
+        parents.push_back(parent);
+        children.emplace_back();
+        if (parent == -1)
+            roots.push_back(clusters[slot]);
+        else
+            children[parent].push_back(clusters[slot]);
+    }
+
+    int cluster_count = bags.size();
+    own_slots.resize(cluster_count);
+    slot_clusters.resize(slot_count);
+    for (int cluster = 0; cluster < cluster_count; ++cluster)
+    {
+        width = std::max<int>(width, bags[cluster].size() - 1);
+        for (auto slot : bags[cluster])
+        {
+            if (parents[cluster] == -1 || !std::binary_search(bags[parents[cluster]].begin(), bags[parents[cluster]].end(), slot))
+            {
+                own_slots[cluster].push_back(slot);
+                slot_clusters[slot] = cluster;
+            }
+        }
+    }
+
+    preorder.resize(cluster_count);
+    subtree_ends.resize(cluster_count);
+    int position = 0;
+    std::vector<std::pair<int, bool>> stack;
+    for (auto root : roots)
+        stack.emplace_back(root, false);
+    while (!stack.empty())
+    {
+        auto [cluster, visited] = stack.back();
+        stack.pop_back();
+        if (visited)
+        {
+            subtree_ends[cluster] = position;
+            continue;
+        }
+
+        preorder[cluster] = position++;
+        stack.emplace_back(cluster, true);
+        for (auto child : children[cluster])
+            stack.emplace_back(child, false);
+    }
+
+    // The cells where a separator slot crosses a slot below it.
+    separator_cells.resize(cluster_count);
+    for (int cluster = 0; cluster < cluster_count; ++cluster)
+    {
+        if (parents[cluster] == -1)
+            continue;
+
+        for (auto slot : bags[cluster])
+        {
+            if (slot_clusters[slot] == cluster)
+                continue;
+
+            for (int j = crossing_graph.offsets[slot]; j < crossing_graph.offsets[slot + 1]; ++j)
+            {
+                const auto& crossing = crossing_graph.crossings[j];
+                if (in_subtree(slot_clusters[crossing.slot], cluster))
+                    separator_cells[cluster].emplace_back(crossing.y, crossing.x);
+            }
+        }
+    }
+}
+
+//! @brief Check whether a cluster lies in the subtree of another.
+//! @param cluster The cluster to look for.
+//! @param subtree_root The root of the subtree.
+//! @return True if the cluster is the root or one of its descendants, false otherwise.
+bool Tree_Decomposition::in_subtree(int cluster, int subtree_root) const
+{
+    return preorder[subtree_root] <= preorder[cluster] && preorder[cluster] < subtree_ends[subtree_root];
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "crossing_graph.h"
+
+#include <utility>
+#include <vector>
+
+struct Tree_Decomposition
+{
+    Tree_Decomposition(const Crossing_Graph&);
+
+    bool in_subtree(int, int) const;
+
+    std::vector<std::vector<int>> bags;
+    std::vector<std::vector<int>> own_slots;
+    std::vector<std::vector<std::pair<int, int>>> separator_cells;
+    std::vector<int> parents;
+    std::vector<std::vector<int>> children;
+    std::vector<int> roots;
+    std::vector<int> slot_clusters;
+    int width = 0;
+
+    private:
+        std::vector<int> preorder;
+        std::vector<int> subtree_ends;
+};
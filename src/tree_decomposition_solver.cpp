@@ -0,0 +1,280 @@
+#include "tree_decomposition_solver.h"
+
+#include <algorithm>
+#include <limits>
+
+//! @brief Create a solver that fills a puzzle cluster by cluster along a tree decomposition.
+//! @param crossing_graph The crossings of every slot.
+//! @param decomposition The tree decomposition of the crossing graph.
+//! @param word_index The dictionary indexed by letter position.
+//! @param statistics The search statistics and budget.
+Tree_Decomposition_Solver::Tree_Decomposition_Solver(const Crossing_Graph& crossing_graph_, const Tree_Decomposition& decomposition_, const Word_Index& word_index_, Search_Statistics& statistics_) :
+    crossing_graph(crossing_graph_),
+    decomposition(decomposition_),
+    word_index(word_index_),
+    statistics(statistics_)
+{}
+
+//! @brief Fill a puzzle, solving the tree of clusters from the roots down.
+//!        Once the subtree below a cluster has been solved or proven unsolvable for the letters its separator fixes,
+//!        the outcome is recorded as a good (with the words found) or a nogood, and reused whenever the same letters
+//!        come up again. The runtime thereby grows exponentially in the width of the decomposition, not the slot count.
+//! @param puzzle The puzzle to fill.
+//! @return The filled puzzle, or nothing if it cannot be filled or the budget ran out.
+std::optional<std::vector<std::vector<char>>> Tree_Decomposition_Solver::solve(const std::vector<std::vector<char>>& puzzle)
+{
+    solution = puzzle;
+    slot_words.assign(crossing_graph.slots.size(), -1);
+    placements.clear();
+    filled_cells.clear();
+    goods.assign(decomposition.bags.size(), {});
+    nogoods.assign(decomposition.bags.size(), {});
+
+    // A slot without any fitting word sinks the whole puzzle, wherever it lies in the tree.
+    for (int i = 0; i < crossing_graph.slots.size(); ++i)
+    {
+        if (count_fitting_words(i) == 0)
+            return std::nullopt;
+    }
+
+    // Separate roots belong to separate parts of the puzzle, so they are solved independently.
+    for (auto root : decomposition.roots)
+    {
+        if (!solve_cluster(root))
+            return std::nullopt;
+    }
+
+    return solution;
+}
+
+//! @brief Fill the slots of a cluster, then solve the subtrees below it.
+//! @param cluster The cluster to solve.
+//! @return True if the cluster and its subtrees could be filled, false otherwise.
+bool Tree_Decomposition_Solver::solve_cluster(int cluster)
+{
+    if (statistics.out_of_budget())
+        return false;
+
+    // Fill the slot with the fewest fitting words first.
+    int slot_index = -1;
+    std::size_t slot_word_count = 0;
+    for (auto slot : decomposition.own_slots[cluster])
+    {
+        if (slot_words[slot] != -1)
+            continue;
+
+        auto word_count = count_fitting_words(slot);
+        if (slot_index == -1 || word_count < slot_word_count)
+        {
+            slot_index = slot;
+            slot_word_count = word_count;
+        }
+    }
+
+    if (slot_index == -1)
+        return solve_children(cluster);
+
+    auto fitting_words = get_fitting_words(slot_index);
+    auto word_count = word_index.get_word_count(crossing_graph.slots[slot_index].length);
+    auto next_word = [&](std::uint32_t from)
+    {
+        if (!fitting_words)
+            return from < word_count ? static_cast<int>(from) : -1;
+
+        auto word = fitting_words->next(from);
+        return word ? static_cast<int>(*word) : -1;
+    };
+
+    for (int candidate = next_word(0); candidate != -1; candidate = next_word(candidate + 1))
+    {
+        if (statistics.out_of_budget())
+            return false;
+
+        auto placement_mark = placements.size();
+        place(slot_index, candidate);
+        ++statistics.nodes;
+        if (crossings_fit(slot_index) && !known_to_fail(cluster) && solve_cluster(cluster))
+            return true;
+
+        undo(placement_mark);
+    }
+
+    if (!statistics.out_of_budget())
+        ++statistics.failures;
+
+    return false;
+}
+
+//! @brief Solve the subtrees below a filled cluster, reusing the outcome recorded for the same separator letters.
+//! @param cluster The filled cluster.
+//! @return True if every subtree could be filled, false otherwise.
+bool Tree_Decomposition_Solver::solve_children(int cluster)
+{
+    // Visit the most constrained subtree first, so that a subtree without any fill fails before its siblings are solved.
+    std::vector<std::pair<std::size_t, int>> children;
+    for (auto child : decomposition.children[cluster])
+    {
+        std::size_t word_count = std::numeric_limits<std::size_t>::max();
+        for (auto slot : decomposition.own_slots[child])
+            word_count = std::min(word_count, count_fitting_words(slot));
+        children.emplace_back(word_count, child);
+    }
+    std::sort(children.begin(), children.end());
+
+    for (auto [word_count, child] : children)
+    {
+        auto separator_key = get_separator_key(child);
+        if (nogoods[child].count(separator_key))
+            return false;
+
+        auto good = goods[child].find(separator_key);
+        if (good != goods[child].end())
+        {
+            for (auto [slot, word] : good->second)
+                place(slot, word);
+            continue;
+        }
+
+        auto placement_mark = placements.size();
+        if (!solve_cluster(child))
+        {
+            if (!statistics.out_of_budget())
+                nogoods[child].insert(separator_key);
+            return false;
+        }
+
+        auto& subtree_words = goods[child][separator_key];
+        for (auto i = placement_mark; i < placements.size(); ++i)
+            subtree_words.emplace_back(placements[i].first, slot_words[placements[i].first]);
+    }
+
+    return true;
+}
+
+//! @brief Check whether the separator of a subtree below a cluster is already filled with letters recorded as a nogood,
+//!        so that the rest of the cluster need not be filled before the dead end is found.
+//! @param cluster The cluster being filled.
+//! @return True if a subtree below the cluster is known to be unsolvable, false otherwise.
+bool Tree_Decomposition_Solver::known_to_fail(int cluster) const
+{
+    for (auto child : decomposition.children[cluster])
+    {
+        if (nogoods[child].empty())
+            continue;
+
+        auto separator_key = get_separator_key(child);
+        if (separator_key.find(' ') == std::string::npos && nogoods[child].count(separator_key))
+            return true;
+    }
+
+    return false;
+}
+
+//! @brief Get the words fitting the letters already in a slot.
+//! @param slot_index The slot.
+//! @return The fitting words, or nullptr if the slot is empty and every word of its length fits.
+std::shared_ptr<const Roaring_Bitmap> Tree_Decomposition_Solver::get_fitting_words(int slot_index) const
+{
+    const auto& slot = crossing_graph.slots[slot_index];
+    std::shared_ptr<const Roaring_Bitmap> fitting_words;
+    int x = slot.x, y = slot.y;
+    for (int i = 0; i < slot.length; ++i)
+    {
+        if (solution[y][x] != ' ')
+        {
+            auto matching_words = word_index.get_words(slot.length, i, solution[y][x]);
+            fitting_words = fitting_words ? std::make_shared<const Roaring_Bitmap>(fitting_words->intersect(*matching_words)) : matching_words;
+            if (fitting_words->cardinality() == 0)
+                break;
+        }
+
+        if (slot.direction == 'a')
+            ++x;
+        else
+            ++y;
+    }
+
+    return fitting_words;
+}
+
+//! @brief Count the words fitting the letters already in a slot.
+//! @param slot_index The slot.
+//! @return The number of fitting words.
+std::size_t Tree_Decomposition_Solver::count_fitting_words(int slot_index) const
+{
+    auto fitting_words = get_fitting_words(slot_index);
+    return fitting_words ? fitting_words->cardinality() : word_index.get_word_count(crossing_graph.slots[slot_index].length);
+}
+
+//! @brief Check that every unfilled slot crossing a slot still has a fitting word.
+//! @param slot_index The slot just filled.
+//! @return True if no crossing slot is left without words, false otherwise.
+bool Tree_Decomposition_Solver::crossings_fit(int slot_index) const
+{
+    for (int i = crossing_graph.offsets[slot_index]; i < crossing_graph.offsets[slot_index + 1]; ++i)
+    {
+        int crossing_slot = crossing_graph.crossings[i].slot;
+        if (slot_words[crossing_slot] == -1 && count_fitting_words(crossing_slot) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+//! @brief Place a word in a slot.
+//! @param slot_index The slot.
+//! @param word The index of the word among the dictionary words of the slot's length.
+void Tree_Decomposition_Solver::place(int slot_index, int word)
+{
+    const auto& slot = crossing_graph.slots[slot_index];
+    placements.emplace_back(slot_index, filled_cells.size());
+    slot_words[slot_index] = word;
+
+    int x = slot.x, y = slot.y;
+    for (auto c : word_index.get_word(slot.length, word))
+    {
+        if (solution[y][x] == ' ')
+        {
+            solution[y][x] = c;
+            filled_cells.emplace_back(y, x);
+        }
+
+        if (slot.direction == 'a')
+            ++x;
+        else
+            ++y;
+    }
+}
+
+//! @brief Take back every word placed after a mark.
+//! @param placement_mark The number of placements to keep.
+void Tree_Decomposition_Solver::undo(std::size_t placement_mark)
+{
+    while (placements.size() > placement_mark)
+    {
+        auto [slot_index, cell_mark] = placements.back();
+        placements.pop_back();
+
+        slot_words[slot_index] = -1;
+        while (filled_cells.size() > cell_mark)
+        {
+            auto [y, x] = filled_cells.back();
+            filled_cells.pop_back();
+
+            solution[y][x] = ' ';
+        }
+    }
+}
+
+//! @brief Get the letters a cluster's separator fixes in the subtree below it.
+//! @param cluster The cluster.
+//! @return The letters, in the order of the separator cells.
+std::string Tree_Decomposition_Solver::get_separator_key(int cluster) const
+{
+    std::string separator_key;
+    separator_key.reserve(decomposition.separator_cells[cluster].size());
+    for (auto [y, x] : decomposition.separator_cells[cluster])
+        separator_key.push_back(solution[y][x]);
+
+    return separator_key;
+}
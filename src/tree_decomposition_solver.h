@@ -0,0 +1,49 @@
+#pragma once
+
+#include "crossing_graph.h"
+#include "roaring_bitmap.h"
+#include "search_statistics.h"
+#include "tree_decomposition.h"
+#include "word_index.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+class Tree_Decomposition_Solver
+{
+    public:
+        Tree_Decomposition_Solver() = delete;
+        Tree_Decomposition_Solver(const Crossing_Graph&, const Tree_Decomposition&, const Word_Index&, Search_Statistics&);
+
+        std::optional<std::vector<std::vector<char>>> solve(const std::vector<std::vector<char>>&);
+
+    private:
+        bool solve_cluster(int);
+        bool solve_children(int);
+        bool known_to_fail(int) const;
+        std::shared_ptr<const Roaring_Bitmap> get_fitting_words(int) const;
+        std::size_t count_fitting_words(int) const;
+        bool crossings_fit(int) const;
+        void place(int, int);
+        void undo(std::size_t);
+        std::string get_separator_key(int) const;
+
+        const Crossing_Graph& crossing_graph;
+        const Tree_Decomposition& decomposition;
+        const Word_Index& word_index;
+        Search_Statistics& statistics;
+
+        std::vector<std::unordered_map<std::string, std::vector<std::pair<int, int>>>> goods;
+        std::vector<std::unordered_set<std::string>> nogoods;
+
+        std::vector<std::vector<char>> solution;
+        std::vector<int> slot_words;
+        std::vector<std::pair<int, std::size_t>> placements;
+        std::vector<std::pair<int, int>> filled_cells;
+};
@@ -0,0 +1,85 @@
+#include "wdeg_heuristic.h"
+
+#include "crossword_utils.h"
+
+#include <algorithm>
+#include <map>
+
+//! @brief Create the crossing weights of every slot, all starting at 1.
+//! @param crossing_graph_ The crossings of every slot.
+WDEG_Heuristic::WDEG_Heuristic(const Crossing_Graph& crossing_graph_) :
+    crossing_graph(crossing_graph_)
+{
+    // Both slots of a crossing share a single weight.
+    std::map<std::pair<int, int>, int> shared_weights;
+    for (int i = 0; i < crossing_graph.slots.size(); ++i)
+    {
+        for (int j = crossing_graph.offsets[i]; j < crossing_graph.offsets[i + 1]; ++j)
+        {
+            auto [weight_index, inserted] = shared_weights.emplace(std::minmax(i, crossing_graph.crossings[j].slot), weights.size());
+            if (inserted)
+                weights.push_back(1);
+
+            weight_indices.push_back(weight_index->second);
+        }
+    }
+}
+
+//! @brief Perform the domain over weighted degree heuristic and get the next slot to fill.
+//!        The weighted degree of a slot sums the weights of its crossings with unassigned, unfilled slots.
+//! @param puzzle The crossword puzzle.
+//! @param checked_words The eligible words of every slot.
+//! @return The index of the unassigned, unfilled slot with the smallest ratio of eligible words to weighted degree, or -1 if there is none.
+int WDEG_Heuristic::perform(const std::vector<std::vector<char>>& puzzle, const Forward_Checking_Data& checked_words) const
+{
+    int slot_index_wdeg = -1;
+    double ratio_wdeg = 0.0;
+    for (int i = 0; i < crossing_graph.slots.size(); ++i)
+    {
+        const auto& slot = crossing_graph.slots[i];
+        if (checked_words.assigned[i] || Crossword_Utils::is_full(puzzle, slot.x, slot.y, slot.direction))
+            continue;
+
+        int weighted_degree = 0;
+        for (int j = crossing_graph.offsets[i]; j < crossing_graph.offsets[i + 1]; ++j)
+        {
+            int crossing_slot_index = crossing_graph.crossings[j].slot;
+            const auto& crossing_slot = crossing_graph.slots[crossing_slot_index];
+            if (!checked_words.assigned[crossing_slot_index] && !Crossword_Utils::is_full(puzzle, crossing_slot.x, crossing_slot.y, crossing_slot.direction))
+                weighted_degree += weights[weight_indices[j]];
+        }
+
+        double ratio = static_cast<double>(checked_words.get_eligible_count(i)) / std::max(weighted_degree, 1);
+        if (slot_index_wdeg == -1 || ratio < ratio_wdeg)
+        {
+            slot_index_wdeg = i;
+            ratio_wdeg = ratio;
+        }
+    }
+
+    return slot_index_wdeg;
+}
+
+//! @brief Forward check the slots crossing a freshly filled slot.
+//!        A crossing slot left without any eligible word bumps the weight of the crossing responsible, unless learning is off.
+//! @param puzzle The crossword puzzle.
+//! @param slot_index The slot that was just filled.
+//! @param checked_words The eligible words of every slot.
+//! @return True if every unassigned crossing slot still has an eligible word, false otherwise.
+bool WDEG_Heuristic::propagate(const std::vector<std::vector<char>>& puzzle, int slot_index, Forward_Checking_Data& checked_words)
+{
+    checked_words.eliminate_words(puzzle, slot_index);
+    for (int i = crossing_graph.offsets[slot_index]; i < crossing_graph.offsets[slot_index + 1]; ++i)
+    {
+        int crossing_slot_index = crossing_graph.crossings[i].slot;
+        if (!checked_words.assigned[crossing_slot_index] && checked_words.get_eligible_count(crossing_slot_index) == 0)
+        {
+            if (learning)
+                ++weights[weight_indices[i]];
+            ++failures;
+            return false;
+        }
+    }
+
+    return true;
+}
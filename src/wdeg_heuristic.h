@@ -0,0 +1,23 @@
+#pragma once
+
+#include "crossing_graph.h"
+#include "forward_checking_data.h"
+
+#include <vector>
+
+struct WDEG_Heuristic
+{
+    WDEG_Heuristic(const Crossing_Graph&);
+
+    int perform(const std::vector<std::vector<char>>&, const Forward_Checking_Data&) const;
+    bool propagate(const std::vector<std::vector<char>>&, int, Forward_Checking_Data&);
+
+    const Crossing_Graph& crossing_graph;
+    std::vector<int> weight_indices;
+    std::vector<int> weights;
+    std::size_t failures = 0;
+    std::size_t restart_failures = 100;
+
+    // Whether wipeouts bump crossing weights; off while sampling the search tree, so that every sample walks the same tree.
+    bool learning = true;
+};
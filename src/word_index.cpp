@@ -0,0 +1,95 @@
+#include "word_index.h"
+
+#include <algorithm>
+#include <functional>
+
+//! @brief Index the dictionary by letter position without copying any word.
+//!        Words are identified by their index in the dictionary list of their length.
+//! @param constrained_words_ Mapping of word length to dictionary words.
+Word_Index::Word_Index(const std::unordered_map<int, std::vector<std::string>>& constrained_words_) :
+    constrained_words(constrained_words_),
+    no_words(std::make_shared<Roaring_Bitmap>())
+{
+    for (const auto& [length, words] : constrained_words)
+    {
+        std::vector<std::array<Roaring_Bitmap, 256>> length_postings(length);
+        for (std::uint32_t word_index = 0; word_index < words.size(); ++word_index)
+        {
+            for (int i = 0; i < length; ++i)
+                length_postings[i][static_cast<unsigned char>(words[word_index][i])].add(word_index);
+        }
+
+        auto& shared_postings = postings[length];
+        shared_postings.resize(length);
+        for (int i = 0; i < length; ++i)
+        {
+            for (int letter = 0; letter < 256; ++letter)
+            {
+                if (length_postings[i][letter].cardinality() > 0)
+                    shared_postings[i][letter] = std::make_shared<Roaring_Bitmap>(std::move(length_postings[i][letter]));
+            }
+        }
+
+        // Word hashes in ascending order, so a word can be looked up without a copy of the dictionary.
+        auto& length_word_hashes = word_hashes[length];
+        length_word_hashes.reserve(words.size());
+        for (std::uint32_t word_index = 0; word_index < words.size(); ++word_index)
+            length_word_hashes.emplace_back(std::hash<std::string>()(words[word_index]), word_index);
+        std::sort(length_word_hashes.begin(), length_word_hashes.end());
+    }
+}
+
+//! @brief Get the words of a length holding a letter at a position.
+//! @param length The word length.
+//! @param position The position of the letter.
+//! @param letter The letter.
+//! @return The indices of the matching words. The bitmap is shared and must not be modified.
+std::shared_ptr<const Roaring_Bitmap> Word_Index::get_words(int length, int position, char letter) const
+{
+    auto length_postings = postings.find(length);
+    if (length_postings == postings.end())
+        return no_words;
+
+    const auto& words = length_postings->second[position][static_cast<unsigned char>(letter)];
+    return words ? words : no_words;
+}
+
+//! @brief Get the number of dictionary words of a length.
+//! @param length The word length.
+//! @return The number of words.
+std::size_t Word_Index::get_word_count(int length) const
+{
+    auto words = constrained_words.find(length);
+    return words == constrained_words.end() ? 0 : words->second.size();
+}
+
+//! @brief Get a dictionary word by its index.
+//! @param length The word length.
+//! @param word_index The index of the word in the dictionary list of its length.
+//! @return The word.
+const std::string& Word_Index::get_word(int length, int word_index) const
+{
+    return constrained_words.at(length)[word_index];
+}
+
+
+//! @brief Check if a word is in the dictionary.
+//! @param word The word.
+//! @return True if the dictionary holds the word, false otherwise.
+bool Word_Index::contains(const std::string& word) const
+{
+    auto length_word_hashes = word_hashes.find(word.length());
+    if (length_word_hashes == word_hashes.end())
+        return false;
+
+    const auto& words = constrained_words.at(word.length());
+    auto hash = std::hash<std::string>()(word);
+    auto position = std::lower_bound(length_word_hashes->second.begin(), length_word_hashes->second.end(), std::make_pair(hash, std::uint32_t(0)));
+    for (; position != length_word_hashes->second.end() && position->first == hash; ++position)
+    {
+        if (words[position->second] == word)
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "roaring_bitmap.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct Word_Index
+{
+    Word_Index(const std::unordered_map<int, std::vector<std::string>>&);
+
+    std::shared_ptr<const Roaring_Bitmap> get_words(int, int, char) const;
+    std::size_t get_word_count(int) const;
+    const std::string& get_word(int, int) const;
+    bool contains(const std::string&) const;
+
+    const std::unordered_map<int, std::vector<std::string>>& constrained_words;
+
+    private:
+        std::unordered_map<int, std::vector<std::array<std::shared_ptr<const Roaring_Bitmap>, 256>>> postings;
+        std::unordered_map<int, std::vector<std::pair<std::size_t, std::uint32_t>>> word_hashes;
+        std::shared_ptr<const Roaring_Bitmap> no_words;
+};